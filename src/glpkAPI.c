@@ -23,14 +23,35 @@
 */
 
 
+#include <limits.h>
 #include <setjmp.h>
+#include <string.h>
 #include "glpkAPI.h"
 #include "glpkCallback.h"
+#include "glpkSnapshot.h"
+#include "glpkCache.h"
+#include "glpkMplData.h"
+#include "glpkBatch.h"
+#include "glpkProf.h"
+#include "glpkMem.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkGen.h"
+#include "glpkCross.h"
+#include "glpkRace.h"
+#include "glpkSweep.h"
+#include "glpkNorm.h"
+#include "glpkLoop.h"
+#include "glpkSample.h"
+#include "glpkBlock.h"
+#include "glpkReduce.h"
+#include "glpkDepend.h"
 
 
 static SEXP tagGLPKprob;
 static SEXP tagGLPKparm;
 static SEXP tagMATHprog;
+static SEXP tagGLPKinfo;
 
 /* for the user callback routine */
 /* static struct cbInfo glpkCallbackInfo; */
@@ -40,6 +61,9 @@ glp_smcp parmS;
 glp_iptcp parmI;
 glp_iocp parmM;
 
+/* argument checks are switched on (if compiled in with CHECK_GLPK_ARGS) */
+int glpkCheckArgs = 1;
+
 /* BEGIN code by Ulrich Wittelsbuerger */
 struct glpkError {
     int e;
@@ -78,6 +102,21 @@ static void glpkProbFinalizer (SEXP lp) {
     }
 }
 
+/* finalizer for per problem data */
+static void glpkInfoFinalizer (SEXP info) {
+    glpkProbInfo *pi = R_ExternalPtrAddr(info);
+    if (!pi) {
+        return;
+    }
+    else {
+        /* the problem object may be finalized after its data */
+        glpkGcRelease(&(pi->bytes));
+        glpkLogFree(pi->log);
+        free(pi);
+        R_ClearExternalPtr(info);
+    }
+}
+
 /* finalizer for MathProg translator workspace */
 static void mathProgFinalizer (SEXP wk) {
     if (!R_ExternalPtrAddr(wk)) {
@@ -125,6 +164,37 @@ SEXP isTRWKSptr(SEXP ptr) {
     return out;
 }
 
+/* per problem data, NULL if not yet created and create is zero */
+static glpkProbInfo *probInfo(SEXP lp, int create) {
+
+    SEXP info = R_ExternalPtrProtected(lp);
+    glpkProbInfo *pi = NULL;
+
+    if ( (TYPEOF(info) == EXTPTRSXP) &&
+         (R_ExternalPtrTag(info) == tagGLPKinfo) ) {
+        pi = R_ExternalPtrAddr(info);
+    }
+
+    if ( (pi == NULL) && create ) {
+        pi = (glpkProbInfo *) calloc(1, sizeof(glpkProbInfo));
+        if (pi == NULL) {
+            Rf_error("Can not allocate memory!");
+        }
+        pi->mem.solver = -1;
+        PROTECT(info = R_MakeExternalPtr(pi, tagGLPKinfo, R_NilValue));
+        R_RegisterCFinalizerEx(info, glpkInfoFinalizer, TRUE);
+        R_SetExternalPtrProtected(lp, info);
+        UNPROTECT(1);
+    }
+
+    return pi;
+}
+
+/* account the memory allocated by GLPK for a problem object since mem0 */
+static void memAccount(SEXP lp, double mem0) {
+    glpkGcAccount(&(probInfo(lp, 1)->bytes), mem0);
+}
+
 /* check for NULL pointer */
 SEXP isNULLptr(SEXP ptr) {
 
@@ -153,6 +223,7 @@ SEXP initGLPK(void) {
     tagGLPKparm = Rf_install("TYPE_GLPK_PARM");
     tagMATHprog = Rf_install("TYPE_MATH_PROG");
     tagGLPKparm = Rf_install("TYPE_GLPK_PARM");
+    tagGLPKinfo = Rf_install("TYPE_GLPK_INFO");
     return R_NilValue;
 }
 
@@ -163,13 +234,20 @@ SEXP delProb(SEXP lp) {
 
     SEXP out = R_NilValue;
     glp_prob *del = NULL;
+    glpkProbInfo *pi;
 
     checkProb(lp);
 
     del = R_ExternalPtrAddr(lp);
 
+    pi = probInfo(lp, 0);
+    if (pi != NULL) {
+        glpkGcRelease(&(pi->bytes));
+    }
+
     glp_delete_prob(del);
     R_ClearExternalPtr(lp);
+    R_SetExternalPtrProtected(lp, R_NilValue);
 
     return out;
 }
@@ -180,13 +258,16 @@ SEXP delProb(SEXP lp) {
 SEXP eraseProb(SEXP lp) {
 
     SEXP out = R_NilValue;
+    double mem0;
     glp_prob *del = NULL;
 
     checkProb(lp);
 
     del = R_ExternalPtrAddr(lp);
 
+    mem0 = glpkMemTotal();
     glp_erase_prob(del);
+    memAccount(lp, mem0);
 
     return out;
 }
@@ -197,6 +278,7 @@ SEXP eraseProb(SEXP lp) {
 SEXP copyProb(SEXP lp, SEXP clp, SEXP names) {
 
     SEXP out = R_NilValue;
+    double mem0;
     glp_prob *prob = NULL;
     glp_prob *dest = NULL;
 
@@ -206,7 +288,9 @@ SEXP copyProb(SEXP lp, SEXP clp, SEXP names) {
     prob = R_ExternalPtrAddr(lp);
     dest = R_ExternalPtrAddr(clp);
 
+    mem0 = glpkMemTotal();
     glp_copy_prob(dest, prob, Rf_asInteger(names));
+    memAccount(clp, mem0);
 
     return out;
 }
@@ -943,11 +1027,14 @@ SEXP getObjDir(SEXP lp) {
 SEXP addRows(SEXP lp, SEXP nrows) {
 
     SEXP out = R_NilValue;
+    double mem0;
     int frow = 0;
 
     checkProb(lp);
 
+    mem0 = glpkMemTotal();
     frow = glp_add_rows(R_ExternalPtrAddr(lp), Rf_asInteger(nrows));
+    memAccount(lp, mem0);
 
     out = Rf_ScalarInteger(frow);
 
@@ -1045,7 +1132,7 @@ SEXP findRow(SEXP lp, SEXP rname) {
     checkProb(lp);
 
     if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
+        glpkGuardHook();
         return out;
     }
 
@@ -1054,7 +1141,7 @@ SEXP findRow(SEXP lp, SEXP rname) {
 
     rind = glp_find_row(R_ExternalPtrAddr(lp), rrname);
 
-    glp_error_hook( NULL, NULL );
+    glpkGuardHook();
 
     out = Rf_ScalarInteger(rind);
 
@@ -1068,11 +1155,14 @@ SEXP findRow(SEXP lp, SEXP rname) {
 SEXP addCols(SEXP lp, SEXP ncols) {
 
     SEXP out = R_NilValue;
+    double mem0;
     int fcol = 0;
 
     checkProb(lp);
 
+    mem0 = glpkMemTotal();
     fcol = glp_add_cols(R_ExternalPtrAddr(lp), Rf_asInteger(ncols));
+    memAccount(lp, mem0);
 
     out = Rf_ScalarInteger(fcol);
 
@@ -1170,7 +1260,7 @@ SEXP findCol(SEXP lp, SEXP cname) {
     checkProb(lp);
 
     if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
+        glpkGuardHook();
         return out;
     }
 
@@ -1179,7 +1269,7 @@ SEXP findCol(SEXP lp, SEXP cname) {
 
     cind = glp_find_col(R_ExternalPtrAddr(lp), rcname);
 
-    glp_error_hook( NULL, NULL );
+    glpkGuardHook();
 
     out = Rf_ScalarInteger(cind);
 
@@ -1890,6 +1980,7 @@ SEXP getObjCoef(SEXP lp, SEXP j) {
 SEXP loadMatrix(SEXP lp, SEXP ne, SEXP ia, SEXP ja, SEXP ra) {
 
     SEXP out = R_NilValue;
+    double mem0;
 
     const int *ria = INTEGER(ia);
     const int *rja = INTEGER(ja);
@@ -1905,7 +1996,7 @@ SEXP loadMatrix(SEXP lp, SEXP ne, SEXP ia, SEXP ja, SEXP ra) {
 
 /*
     if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
+        glpkGuardHook();
         return out;
     }
 
@@ -1913,11 +2004,13 @@ SEXP loadMatrix(SEXP lp, SEXP ne, SEXP ia, SEXP ja, SEXP ra) {
     glp_error_hook( (func) &cleanGLPKerror, &ge );
 */
 
+    mem0 = glpkMemTotal();
     glp_load_matrix(R_ExternalPtrAddr(lp), Rf_asInteger(ne),
                     &(ria[-1]), &(rja[-1]), &(rra[-1]));
+    memAccount(lp, mem0);
 
 /*
-    glp_error_hook( NULL, NULL );
+    glpkGuardHook();
 */
 
     return out;
@@ -1962,6 +2055,7 @@ SEXP sortMatrix(SEXP lp) {
 SEXP delRows(SEXP lp, SEXP nrows, SEXP i) {
 
     SEXP out = R_NilValue;
+    double mem0;
 
     const int *ri = INTEGER(i);
 
@@ -1969,7 +2063,9 @@ SEXP delRows(SEXP lp, SEXP nrows, SEXP i) {
     checkVecLen(Rf_ScalarInteger(Rf_asInteger(nrows) + 1), i);
     checkRowIndices(lp, i, 1);
 
+    mem0 = glpkMemTotal();
     glp_del_rows(R_ExternalPtrAddr(lp), Rf_asInteger(nrows), ri);
+    memAccount(lp, mem0);
 
     return out;
 }
@@ -1980,6 +2076,7 @@ SEXP delRows(SEXP lp, SEXP nrows, SEXP i) {
 SEXP delCols(SEXP lp, SEXP ncols, SEXP j) {
 
     SEXP out = R_NilValue;
+    double mem0;
 
     const int *rj = INTEGER(j);
 
@@ -1987,7 +2084,9 @@ SEXP delCols(SEXP lp, SEXP ncols, SEXP j) {
     checkVecLen(Rf_ScalarInteger(Rf_asInteger(ncols) + 1), j);
     checkColIndices(lp, j, 1);
 
+    mem0 = glpkMemTotal();
     glp_del_cols(R_ExternalPtrAddr(lp), Rf_asInteger(ncols), rj);
+    memAccount(lp, mem0);
 
     return out;
 }
@@ -2209,6 +2308,7 @@ SEXP termOut(SEXP flag) {
 SEXP solveSimplex(SEXP lp) {
 
     SEXP out = R_NilValue;
+    double mem0;
     int ret = 0;
 
     checkProb(lp);
@@ -2218,7 +2318,10 @@ SEXP solveSimplex(SEXP lp) {
     glp_init_smcp(&parmS);
     parmS.tm_lim = 10000;
     */
-    ret = glp_simplex(R_ExternalPtrAddr(lp), &parmS);
+    mem0 = glpkMemTotal();
+    ret = glpkSolveSimplex(R_ExternalPtrAddr(lp), &parmS,
+                           probInfo(lp, 1));
+    memAccount(lp, mem0);
     /* ret = glp_simplex(R_ExternalPtrAddr(lp), NULL); */
 
     out = Rf_ScalarInteger(ret);
@@ -2232,11 +2335,14 @@ SEXP solveSimplex(SEXP lp) {
 SEXP solveSimplexExact(SEXP lp) {
 
     SEXP out = R_NilValue;
+    double mem0;
     int ret = 0;
 
     checkProb(lp);
 
-    ret = glp_exact(R_ExternalPtrAddr(lp), &parmS);
+    mem0 = glpkMemTotal();
+    ret = glpkSolveExact(R_ExternalPtrAddr(lp), &parmS, probInfo(lp, 1));
+    memAccount(lp, mem0);
     /* ret = glp_exact(R_ExternalPtrAddr(lp), NULL); */
 
     out = Rf_ScalarInteger(ret);
@@ -2245,6 +2351,32 @@ SEXP solveSimplexExact(SEXP lp) {
 }
 
 
+/* -------------------------------------------------------------------------- */
+/* solve problem with simplex algorithm and verify in exact arithmetic */
+SEXP solveSimplexHybrid(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double mem0;
+    int ret = 0;
+    int stage, xiter;
+
+    checkProb(lp);
+
+    mem0 = glpkMemTotal();
+    ret = glpkSolveHybrid(R_ExternalPtrAddr(lp), &parmS, probInfo(lp, 1),
+                          &stage, &xiter);
+    memAccount(lp, mem0);
+
+    PROTECT(out = Rf_ScalarInteger(ret));
+    Rf_setAttrib(out, Rf_install("stage"), Rf_ScalarInteger(stage));
+    Rf_setAttrib(out, Rf_install("exact_iter"),
+                 Rf_ScalarInteger((xiter < 0) ? NA_INTEGER : xiter));
+    UNPROTECT(1);
+
+    return out;
+}
+
+
 /* -------------------------------------------------------------------------- */
 /* get value of the objective function after simplex */
 SEXP getObjVal(SEXP lp) {
@@ -2587,11 +2719,15 @@ SEXP getUnbndRay(SEXP lp) {
 SEXP solveInterior(SEXP lp) {
 
     SEXP out = R_NilValue;
+    double mem0;
     int ret = 0;
 
     checkProb(lp);
 
-    ret = glp_interior(R_ExternalPtrAddr(lp), &parmI);
+    mem0 = glpkMemTotal();
+    ret = glpkSolveInterior(R_ExternalPtrAddr(lp), &parmI,
+                            probInfo(lp, 1));
+    memAccount(lp, mem0);
     /* ret = glp_interior(R_ExternalPtrAddr(lp), NULL); */
 
     out = Rf_ScalarInteger(ret);
@@ -2601,324 +2737,790 @@ SEXP solveInterior(SEXP lp) {
 
 
 /* -------------------------------------------------------------------------- */
-/* get value of the objective function after interior point method */
-SEXP getObjValIpt(SEXP lp) {
+/* crossover from the interior point solution to an optimal basis */
+SEXP crossover(SEXP lp, SEXP solve) {
 
     SEXP out = R_NilValue;
-    double obj_val = 0;
+    glpkCrossStat st;
+    double mem0;
+    int ret = 0;
+    int ipt = NA_INTEGER;
 
     checkProb(lp);
 
-    obj_val = glp_ipt_obj_val(R_ExternalPtrAddr(lp));
-
-    out = Rf_ScalarReal(obj_val);
+    mem0 = glpkMemTotal();
+    if (Rf_asLogical(solve) == TRUE) {
+        ipt = glpkSolveInterior(R_ExternalPtrAddr(lp), &parmI,
+                                probInfo(lp, 1));
+    }
+    /* the interior point values of a failed solve are meaningless */
+    if ( ( (ipt != NA_INTEGER) && (ipt != 0) ) ||
+         (glp_ipt_status(R_ExternalPtrAddr(lp)) != GLP_OPT) ) {
+        ret = ( (ipt != NA_INTEGER) && (ipt != 0) ) ? ipt : GLP_EFAIL;
+        memset(&st, 0, sizeof(st));
+        st.iter = -1;
+    }
+    else {
+        ret = glpkCrossover(R_ExternalPtrAddr(lp), &parmS, probInfo(lp, 1),
+                            &st);
+    }
+    memAccount(lp, mem0);
+
+    PROTECT(out = Rf_ScalarInteger(ret));
+    Rf_setAttrib(out, Rf_install("interior"), Rf_ScalarInteger(ipt));
+    Rf_setAttrib(out, Rf_install("candidates"), Rf_ScalarInteger(st.ncand));
+    Rf_setAttrib(out, Rf_install("basic"), Rf_ScalarInteger(st.nbasic));
+    Rf_setAttrib(out, Rf_install("crash"), Rf_ScalarLogical(st.crash != 0));
+    Rf_setAttrib(out, Rf_install("iter"),
+                 Rf_ScalarInteger( (st.iter < 0) ? NA_INTEGER : st.iter ));
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* get solution status after interior point method */
-SEXP getSolStatIpt(SEXP lp) {
+/* solve with several methods at the same time, the first one wins */
+SEXP solveConcurrent(SEXP lp, SEXP methods) {
 
     SEXP out = R_NilValue;
-    int stat = 0;
+    glpkRaceStat st;
+    double mem0;
+    int ret = 0;
 
     checkProb(lp);
 
-    stat = glp_ipt_status(R_ExternalPtrAddr(lp));
+    mem0 = glpkMemTotal();
+    ret = glpkRace(R_ExternalPtrAddr(lp), &parmS, &parmI,
+                   Rf_asInteger(methods), probInfo(lp, 1), &st);
+    memAccount(lp, mem0);
 
-    out = Rf_ScalarInteger(stat);
+    PROTECT(out = Rf_ScalarInteger(ret));
+    Rf_setAttrib(out, Rf_install("winner"), Rf_ScalarInteger(st.winner));
+    Rf_setAttrib(out, Rf_install("threads"), Rf_ScalarInteger(st.nthreads));
+    Rf_setAttrib(out, Rf_install("time"), Rf_ScalarReal(st.secs));
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* get column primal value (flux distribution) for all columns (interior) */
-SEXP getColsPrimIpt(SEXP lp) {
+/* solve for a series of objectives, each starting from the previous basis */
+SEXP sweepObj(SEXP lp, SEXP p, SEXP ind, SEXP val, SEXP prim) {
 
-    SEXP out = R_NilValue;
-    double col_prim = 0;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP obj, stat, ret, cprim = R_NilValue;
+    double mem0;
+    int k, n, nobj, nsolved;
 
-    int num_cols, k;
+    const int *rp = INTEGER(p);
 
     checkProb(lp);
+    checkColIndices(lp, ind, NULL);
 
-    num_cols = glp_get_num_cols(R_ExternalPtrAddr(lp));
-
-    PROTECT(out = Rf_allocVector(REALSXP, num_cols));
-    for (k = 1; k <= num_cols; k++) {
-        col_prim = glp_ipt_col_prim(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = col_prim;
+    nobj = Rf_length(p) - 1;
+    if ( (nobj < 0) || (rp[0] != 0) || (rp[nobj] != Rf_length(ind)) ||
+         (Rf_length(ind) != Rf_length(val)) ) {
+        Rf_error("Invalid objective matrix!");
+    }
+    for (k = 0; k < nobj; k++) {
+        if (rp[k+1] < rp[k]) {
+            Rf_error("Invalid objective matrix!");
+        }
     }
-    UNPROTECT(1);
 
-    return out;
-}
+    n = glp_get_num_cols(R_ExternalPtrAddr(lp));
 
+    PROTECT(obj  = Rf_allocVector(REALSXP, nobj));
+    PROTECT(stat = Rf_allocVector(INTSXP, nobj));
+    PROTECT(ret  = Rf_allocVector(INTSXP, nobj));
+    if (Rf_asLogical(prim) == TRUE) {
+        cprim = Rf_allocMatrix(REALSXP, n, nobj);
+    }
+    PROTECT(cprim);
 
-/* -------------------------------------------------------------------------- */
-/* get column primal value (flux distribution) for one column (interior) */
-SEXP getColPrimIpt(SEXP lp, SEXP j) {
+    mem0 = glpkMemTotal();
+    nsolved = glpkSweepObj(R_ExternalPtrAddr(lp), &parmS, probInfo(lp, 1),
+                           nobj, rp, INTEGER(ind), REAL(val),
+                           REAL(obj), INTEGER(stat), INTEGER(ret),
+                           (cprim == R_NilValue) ? NULL : REAL(cprim));
+    memAccount(lp, mem0);
 
-    SEXP out = R_NilValue;
-    double col_prim = 0;
+    if (nsolved < 0) {
+        UNPROTECT(4);
+        Rf_error("Out of memory!");
+    }
 
-    checkProb(lp);
-    checkColIndex(lp, j);
+    PROTECT(out = Rf_allocVector(VECSXP, 4));
+    SET_VECTOR_ELT(out, 0, obj);
+    SET_VECTOR_ELT(out, 1, stat);
+    SET_VECTOR_ELT(out, 2, ret);
+    SET_VECTOR_ELT(out, 3, cprim);
 
-    col_prim = glp_ipt_col_prim(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+    PROTECT(listv = Rf_allocVector(STRSXP, 4));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("obj"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("stat"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("ret"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("prim"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    out = Rf_ScalarReal(col_prim);
+    UNPROTECT(6);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve row primal value (interior) */
-SEXP getRowPrimIpt(SEXP lp, SEXP i) {
+/* solve for a grid of fixed values of two columns */
+SEXP sweepGrid(SEXP lp, SEXP j1, SEXP j2, SEXP g1, SEXP g2, SEXP nthreads) {
 
-    SEXP out = R_NilValue;
-    double row_prim = 0;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP obj, stat;
+    glpkGrid gr;
+    double mem0;
+    int ret, nw = 0;
 
     checkProb(lp);
-    checkRowIndex(lp, i);
+    checkColIndex(lp, j1);
+    checkColIndex(lp, j2);
 
-    row_prim = glp_ipt_row_prim(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+    gr.j1 = Rf_asInteger(j1);
+    gr.j2 = Rf_asInteger(j2);
+    gr.n1 = Rf_length(g1);
+    gr.n2 = Rf_length(g2);
+    gr.g1 = REAL(g1);
+    gr.g2 = REAL(g2);
 
-    out = Rf_ScalarReal(row_prim);
+    if (gr.j1 == gr.j2) {
+        Rf_error("Grid columns must differ!");
+    }
+
+    PROTECT(obj  = Rf_allocMatrix(REALSXP, gr.n1, gr.n2));
+    PROTECT(stat = Rf_allocMatrix(INTSXP, gr.n1, gr.n2));
+    gr.obj  = REAL(obj);
+    gr.stat = INTEGER(stat);
+
+    mem0 = glpkMemTotal();
+    ret = glpkSweepGrid(R_ExternalPtrAddr(lp), &parmS, probInfo(lp, 1), &gr,
+                        Rf_asInteger(nthreads), &nw);
+    memAccount(lp, mem0);
+
+    PROTECT(out = Rf_allocVector(VECSXP, 2));
+    SET_VECTOR_ELT(out, 0, obj);
+    SET_VECTOR_ELT(out, 1, stat);
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 2));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("obj"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("stat"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    Rf_setAttrib(out, Rf_install("ret"), Rf_ScalarInteger(ret));
+    Rf_setAttrib(out, Rf_install("threads"), Rf_ScalarInteger(nw));
+
+    UNPROTECT(4);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve row primal value (interior) for all rows (interior) */
-SEXP getRowsPrimIpt(SEXP lp) {
+/* minimize a weighted L1 norm of columns */
+SEXP solveNormL1(SEXP lp, SEXP ind, SEXP ref, SEXP w, SEXP frac) {
 
-    SEXP out = R_NilValue;
-    double row_prim = 0;
-
-    int num_rows, k;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP prim;
+    glp_prob *P;
+    double mem0, norm, fr;
+    int ret, stat, nc;
 
     checkProb(lp);
+    checkColIndices(lp, ind, NULL);
 
-    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
+    P  = R_ExternalPtrAddr(lp);
+    nc = Rf_length(ind);
+    fr = Rf_asReal(frac);
 
-    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
-    for (k = 1; k <= num_rows; k++) {
-        row_prim = glp_ipt_row_prim(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = row_prim;
+    if ( ( (ref != R_NilValue) && (Rf_length(ref) != nc) ) ||
+         ( (w != R_NilValue) && (Rf_length(w) != nc) ) ) {
+        Rf_error("Vector does not have length %i!", nc);
+    }
+    if ( (!ISNAN(fr)) && (fr >= 0) && (glp_get_status(P) != GLP_OPT) ) {
+        Rf_error("The objective can not be fixed without an optimal solution!");
+    }
+    if (ISNAN(fr)) {
+        fr = -1;
     }
-    UNPROTECT(1);
 
-    return out;
-}
+    PROTECT(prim = Rf_allocVector(REALSXP, glp_get_num_cols(P)));
 
+    mem0 = glpkMemTotal();
+    ret = glpkNormL1(P, &parmS, probInfo(lp, 1), nc, INTEGER(ind),
+                     (ref == R_NilValue) ? NULL : REAL(ref),
+                     (w == R_NilValue) ? NULL : REAL(w),
+                     fr, REAL(prim), &norm, &stat);
+    memAccount(lp, mem0);
 
-/* -------------------------------------------------------------------------- */
-/* retrieve row dual value (interior) */
-SEXP getRowDualIpt(SEXP lp, SEXP i) {
+    if (ret < 0) {
+        UNPROTECT(1);
+        Rf_error("Out of memory!");
+    }
 
-    SEXP out = R_NilValue;
-    double row_dual = 0;
+    PROTECT(out = Rf_allocVector(VECSXP, 3));
+    SET_VECTOR_ELT(out, 0, Rf_ScalarReal(norm));
+    SET_VECTOR_ELT(out, 1, Rf_ScalarInteger(stat));
+    SET_VECTOR_ELT(out, 2, prim);
 
-    checkProb(lp);
-    checkRowIndex(lp, i);
+    PROTECT(listv = Rf_allocVector(STRSXP, 3));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("norm"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("stat"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("prim"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    row_dual = glp_ipt_row_dual(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+    Rf_setAttrib(out, Rf_install("ret"), Rf_ScalarInteger(ret));
 
-    out = Rf_ScalarReal(row_dual);
+    UNPROTECT(3);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve row dual value (interior) for all rows (interior) */
-SEXP getRowsDualIpt(SEXP lp) {
-
-    SEXP out = R_NilValue;
-    double row_dual = 0;
+/* append loopless constraints for internal reactions */
+SEXP addLoopless(SEXP lp, SEXP ind, SEXP bigM, SEXP eps) {
 
-    int num_rows, k;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP ia, ig, ir;
+    glpkLoopStat st;
+    double mem0;
+    int k, nc, nr, err;
 
     checkProb(lp);
+    checkColIndices(lp, ind, NULL);
 
-    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
-
-    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
-    for (k = 1; k <= num_rows; k++) {
-        row_dual = glp_ipt_row_dual(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = row_dual;
-    }
-    UNPROTECT(1);
+    nc = Rf_length(ind);
 
-    return out;
-}
+    mem0 = glpkMemTotal();
+    err = glpkLoopless(R_ExternalPtrAddr(lp), nc, INTEGER(ind),
+                       Rf_asReal(bigM), Rf_asReal(eps), &st);
+    memAccount(lp, mem0);
 
+    if (err != 0) {
+        Rf_error("Out of memory!");
+    }
 
-/* -------------------------------------------------------------------------- */
-/* retrieve column dual value (interior) */
-SEXP getColDualIpt(SEXP lp, SEXP j) {
+    nr = 2 * nc + st.nnull;
 
-    SEXP out = R_NilValue;
-    double col_dual = 0;
+    PROTECT(ia = Rf_allocVector(INTSXP, nc));
+    PROTECT(ig = Rf_allocVector(INTSXP, nc));
+    PROTECT(ir = Rf_allocVector(INTSXP, nr));
+    for (k = 0; k < nc; k++) {
+        INTEGER(ia)[k] = st.col0 + 1 + k;
+        INTEGER(ig)[k] = st.col0 + 1 + nc + k;
+    }
+    for (k = 0; k < nr; k++) {
+        INTEGER(ir)[k] = st.row0 + 1 + k;
+    }
 
-    checkProb(lp);
-    checkColIndex(lp, j);
+    PROTECT(out = Rf_allocVector(VECSXP, 5));
+    SET_VECTOR_ELT(out, 0, ia);
+    SET_VECTOR_ELT(out, 1, ig);
+    SET_VECTOR_ELT(out, 2, ir);
+    SET_VECTOR_ELT(out, 3, Rf_ScalarInteger(st.nnull));
+    SET_VECTOR_ELT(out, 4, Rf_ScalarInteger(st.rank));
 
-    col_dual = glp_ipt_col_dual(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+    PROTECT(listv = Rf_allocVector(STRSXP, 5));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("indicator"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("energy"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("rows"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("nullity"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("rank"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    out = Rf_ScalarReal(col_dual);
+    UNPROTECT(5);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve column dual value (interior) for all columns (interior) */
-SEXP getColsDualIpt(SEXP lp) {
+/* artificial centering hit-and-run sampling */
+SEXP sampleACHR(SEXP lp, SEXP warm, SEXP npoints, SEXP thin, SEXP chains,
+                SEXP seed, SEXP fname) {
 
     SEXP out = R_NilValue;
-    double col_dual = 0;
-
-    int num_cols, k;
+    glpkSample sp;
+    FILE *fp = NULL;
+    int n, nwarm, np, got, intr = 0;
 
     checkProb(lp);
 
-    num_cols = glp_get_num_cols(R_ExternalPtrAddr(lp));
+    n  = glp_get_num_cols(R_ExternalPtrAddr(lp));
+    np = Rf_asInteger(npoints);
+    nwarm = (n > 0) ? Rf_length(warm) / n : 0;
 
-    PROTECT(out = Rf_allocVector(REALSXP, num_cols));
-    for (k = 1; k <= num_cols; k++) {
-        col_dual = glp_ipt_col_dual(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = col_dual;
+    if ( (nwarm < 1) || (Rf_length(warm) != n * nwarm) ) {
+        Rf_error("Invalid warm-up points!");
+    }
+    if ( (np == NA_INTEGER) || (np < 0) || (Rf_length(chains) != 2) ) {
+        Rf_error("Invalid number of points or chains!");
     }
-    UNPROTECT(1);
 
-    return out;
-}
+    if (fname != R_NilValue) {
+        fp = fopen(CHAR(STRING_ELT(fname, 0)), "w");
+        if (fp == NULL) {
+            Rf_error("Can not open file '%s'!", CHAR(STRING_ELT(fname, 0)));
+        }
+    }
+    else {
+        out = Rf_allocMatrix(REALSXP, n, np);
+    }
+    PROTECT(out);
 
+    if (glpkSampleInit(&sp, R_ExternalPtrAddr(lp), nwarm, REAL(warm)) != 0) {
+        if (fp != NULL) {
+            fclose(fp);
+        }
+        UNPROTECT(1);
+        Rf_error("Out of memory!");
+    }
 
-/* -------------------------------------------------------------------------- */
-/* solve MIP problem with the branch-and-cut method */
-SEXP solveMIP(SEXP lp) {
+    got = glpkSampleRun(&sp, np, Rf_asInteger(thin), INTEGER(chains)[0],
+                        INTEGER(chains)[1], (unsigned int) Rf_asInteger(seed),
+                        (fp == NULL) ? REAL(out) : NULL, fp, &intr);
 
-    SEXP out = R_NilValue;
-    int ret = 0;
+    glpkSampleFree(&sp);
+    if (fp != NULL) {
+        fclose(fp);
+    }
 
-    checkProb(lp);
+    if (got < 0) {
+        UNPROTECT(1);
+        Rf_error("Out of memory!");
+    }
 
-    ret = glp_intopt(R_ExternalPtrAddr(lp), &parmM);
+    if (fp != NULL) {
+        UNPROTECT(1);
+        PROTECT(out = Rf_ScalarInteger(got));
+    }
+    Rf_setAttrib(out, Rf_install("points"), Rf_ScalarInteger(got));
+    Rf_setAttrib(out, Rf_install("interrupted"), Rf_ScalarLogical(intr != 0));
 
-    out = Rf_ScalarInteger(ret);
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* determine status of MIP solution */
-SEXP mipStatus(SEXP lp) {
+/* find (and delete) columns which are zero in every feasible point */
+SEXP findBlocked(SEXP lp, SEXP tol, SEXP nrandom, SEXP seed, SEXP del) {
 
-    SEXP out = R_NilValue;
-    int stat = 0;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP blocked, colmap = R_NilValue, rowmap = R_NilValue;
+    glp_prob *P;
+    glpkBlockStat st;
+    int *bl, *cm = NULL, *rm = NULL;
+    double mem0;
+    int j, m, n, nc = 0, nr = 0, ret, err = 0;
 
     checkProb(lp);
 
-    stat = glp_mip_status(R_ExternalPtrAddr(lp));
+    P = R_ExternalPtrAddr(lp);
+    m = glp_get_num_rows(P);
+    n = glp_get_num_cols(P);
 
-    out = Rf_ScalarInteger(stat);
+    bl = (int *) R_alloc((size_t) n + 1, sizeof(int));
 
-    return out;
-}
+    mem0 = glpkMemTotal();
+    ret = glpkBlocked(P, &parmS, probInfo(lp, 1), Rf_asReal(tol),
+                      Rf_asInteger(nrandom), (unsigned int) Rf_asInteger(seed),
+                      bl, &st);
+    if ( (ret == 0) && (Rf_asLogical(del) == TRUE) ) {
+        cm = (int *) R_alloc((size_t) n + 1, sizeof(int));
+        rm = (int *) R_alloc((size_t) m + 1, sizeof(int));
+        err = glpkBlockedDelete(P, bl, cm, rm, &nc, &nr);
+    }
+    memAccount(lp, mem0);
 
+    if ( (ret < 0) || (err != 0) ) {
+        Rf_error("Out of memory!");
+    }
 
-/* -------------------------------------------------------------------------- */
-/* retrieve objective value */
-SEXP mipObjVal(SEXP lp) {
+    PROTECT(blocked = Rf_allocVector(LGLSXP, n));
+    for (j = 0; j < n; j++) {
+        LOGICAL(blocked)[j] = (ret == 0) ? bl[j] : NA_LOGICAL;
+    }
 
-    SEXP out = R_NilValue;
-    double obj_val = 0;
+    if (cm != NULL) {
+        colmap = Rf_allocVector(INTSXP, nc);
+        for (j = 0; j < nc; j++) {
+            INTEGER(colmap)[j] = cm[j];
+        }
+    }
+    PROTECT(colmap);
+    if (rm != NULL) {
+        rowmap = Rf_allocVector(INTSXP, nr);
+        for (j = 0; j < nr; j++) {
+            INTEGER(rowmap)[j] = rm[j];
+        }
+    }
+    PROTECT(rowmap);
 
-    checkProb(lp);
+    PROTECT(out = Rf_allocVector(VECSXP, 3));
+    SET_VECTOR_ELT(out, 0, blocked);
+    SET_VECTOR_ELT(out, 1, colmap);
+    SET_VECTOR_ELT(out, 2, rowmap);
 
-    obj_val = glp_mip_obj_val(R_ExternalPtrAddr(lp));
+    PROTECT(listv = Rf_allocVector(STRSXP, 3));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("blocked"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("colmap"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("rowmap"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    out = Rf_ScalarReal(obj_val);
+    Rf_setAttrib(out, Rf_install("ret"), Rf_ScalarInteger(ret));
+    Rf_setAttrib(out, Rf_install("lps"), Rf_ScalarInteger(st.nlp));
+    Rf_setAttrib(out, Rf_install("single"), Rf_ScalarInteger(st.nsingle));
+
+    UNPROTECT(5);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve row value (MIP) */
-SEXP mipRowVal(SEXP lp, SEXP i) {
+/* reduce problem lp into problem rlp, keep the reductions for postsolve */
+SEXP reduceProb(SEXP lp, SEXP rlp, SEXP tol) {
 
-    SEXP out = R_NilValue;
-    double row = 0;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP dims, rowmap, colmap, iop, dop;
+    glp_prob *P, *Q;
+    glpkReduceMap map;
+    int *rm, *cm, *io;
+    double *dd;
+    double mem0;
+    int k, m, n, cap, nop, nr, nc, ret;
 
     checkProb(lp);
-    checkRowIndex(lp, i);
+    checkProb(rlp);
 
-    row = glp_mip_row_val(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+    P = R_ExternalPtrAddr(lp);
+    Q = R_ExternalPtrAddr(rlp);
 
-    out = Rf_ScalarReal(row);
+    if (P == Q) {
+        Rf_error("Arguments 'lp' and 'rlp' must be different problems!");
+    }
 
-    return out;
-}
+    m   = glp_get_num_rows(P);
+    n   = glp_get_num_cols(P);
+    cap = m + n + 1;
 
+    /* the reductions are copied here before anything can raise an error */
+    rm = (int *) R_alloc((size_t) m + 1, sizeof(int));
+    cm = (int *) R_alloc((size_t) n + 1, sizeof(int));
+    io = (int *) R_alloc(4 * (size_t) cap, sizeof(int));
+    dd = (double *) R_alloc(3 * (size_t) cap, sizeof(double));
 
-/* -------------------------------------------------------------------------- */
-/* retrieve row value for all rows (MIP) */
-SEXP mipRowsVal(SEXP lp) {
+    mem0 = glpkMemTotal();
+    glp_erase_prob(Q);
+    ret = glpkReduce(P, Q, Rf_asReal(tol), &map);
+    memAccount(rlp, mem0);
 
-    SEXP out = R_NilValue;
-    double row = 0;
+    if (ret < 0) {
+        Rf_error("Out of memory!");
+    }
 
-    int num_rows, k;
+    nop = map.nop;
+    nr  = map.nr;
+    nc  = map.nc;
+    memcpy(rm, map.rowmap, (size_t) nr * sizeof(int));
+    memcpy(cm, map.colmap, (size_t) nc * sizeof(int));
+    memcpy(io, map.iop, 4 * (size_t) nop * sizeof(int));
+    memcpy(dd, map.dop, 3 * (size_t) nop * sizeof(double));
+    glpkReduceFree(&map);
+
+    PROTECT(dims = Rf_allocVector(INTSXP, 2));
+    INTEGER(dims)[0] = m;
+    INTEGER(dims)[1] = n;
+
+    PROTECT(rowmap = Rf_allocVector(INTSXP, nr));
+    for (k = 0; k < nr; k++) {
+        INTEGER(rowmap)[k] = rm[k];
+    }
+    PROTECT(colmap = Rf_allocVector(INTSXP, nc));
+    for (k = 0; k < nc; k++) {
+        INTEGER(colmap)[k] = cm[k];
+    }
+    PROTECT(iop = Rf_allocMatrix(INTSXP, nop, 4));
+    for (k = 0; k < 4 * nop; k++) {
+        INTEGER(iop)[k] = io[k];
+    }
+    PROTECT(dop = Rf_allocMatrix(REALSXP, nop, 3));
+    for (k = 0; k < 3 * nop; k++) {
+        REAL(dop)[k] = dd[k];
+    }
 
-    checkProb(lp);
+    PROTECT(out = Rf_allocVector(VECSXP, 5));
+    SET_VECTOR_ELT(out, 0, dims);
+    SET_VECTOR_ELT(out, 1, rowmap);
+    SET_VECTOR_ELT(out, 2, colmap);
+    SET_VECTOR_ELT(out, 3, iop);
+    SET_VECTOR_ELT(out, 4, dop);
 
-    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
+    PROTECT(listv = Rf_allocVector(STRSXP, 5));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("dims"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("rowmap"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("colmap"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("iop"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("dop"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
-    for (k = 1; k <= num_rows; k++) {
-        row = glp_mip_row_val(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = row;
-    }
-    UNPROTECT(1);
+    Rf_setAttrib(out, Rf_install("ret"), Rf_ScalarInteger(ret));
+
+    UNPROTECT(7);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve column value (MIP) */
-SEXP mipColVal(SEXP lp, SEXP j) {
+/* map the basic solution of a reduced problem back to the original problem */
+SEXP postsolve(SEXP lp, SEXP rlp, SEXP map) {
 
-    SEXP out = R_NilValue;
-    double col = 0;
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP dims, rowmap, colmap, iop, dop;
+    SEXP cprim, cdual, rprim, rdual;
+    glp_prob *P, *Q;
+    glpkReduceMap mp;
 
     checkProb(lp);
-    checkColIndex(lp, j);
+    checkProb(rlp);
 
-    col = glp_mip_col_val(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+    P = R_ExternalPtrAddr(lp);
+    Q = R_ExternalPtrAddr(rlp);
 
-    out = Rf_ScalarReal(col);
+    if ( (TYPEOF(map) != VECSXP) || (Rf_length(map) != 5) ) {
+        Rf_error("Argument 'map' is not a reduction map!");
+    }
+    dims   = VECTOR_ELT(map, 0);
+    rowmap = VECTOR_ELT(map, 1);
+    colmap = VECTOR_ELT(map, 2);
+    iop    = VECTOR_ELT(map, 3);
+    dop    = VECTOR_ELT(map, 4);
+    if ( (TYPEOF(dims) != INTSXP) || (Rf_length(dims) != 2) ||
+         (TYPEOF(rowmap) != INTSXP) || (TYPEOF(colmap) != INTSXP) ||
+         (TYPEOF(iop) != INTSXP) || (TYPEOF(dop) != REALSXP) ||
+         (Rf_length(iop) % 4 != 0) ||
+         (Rf_length(dop) != 3 * (Rf_length(iop) / 4)) ) {
+        Rf_error("Argument 'map' is not a reduction map!");
+    }
+
+    mp.m      = INTEGER(dims)[0];
+    mp.n      = INTEGER(dims)[1];
+    mp.nr     = Rf_length(rowmap);
+    mp.nc     = Rf_length(colmap);
+    mp.rowmap = INTEGER(rowmap);
+    mp.colmap = INTEGER(colmap);
+    mp.nop    = Rf_length(iop) / 4;
+    mp.iop    = INTEGER(iop);
+    mp.dop    = REAL(dop);
+
+    if ( (mp.m != glp_get_num_rows(P)) || (mp.n != glp_get_num_cols(P)) ) {
+        Rf_error("Argument 'map' does not belong to problem 'lp'!");
+    }
+    if ( (mp.nr != glp_get_num_rows(Q)) || (mp.nc != glp_get_num_cols(Q)) ) {
+        Rf_error("Argument 'map' does not belong to problem 'rlp'!");
+    }
+    if (glpkReduceCheck(&mp) != 0) {
+        Rf_error("Argument 'map' is not a reduction map!");
+    }
+
+    PROTECT(cprim = Rf_allocVector(REALSXP, mp.n));
+    PROTECT(cdual = Rf_allocVector(REALSXP, mp.n));
+    PROTECT(rprim = Rf_allocVector(REALSXP, mp.m));
+    PROTECT(rdual = Rf_allocVector(REALSXP, mp.m));
+
+    if (glpkPostsolve(P, Q, &mp, REAL(cprim), REAL(cdual), REAL(rprim),
+                      REAL(rdual)) != 0) {
+        Rf_error("Out of memory!");
+    }
+
+    PROTECT(out = Rf_allocVector(VECSXP, 4));
+    SET_VECTOR_ELT(out, 0, cprim);
+    SET_VECTOR_ELT(out, 1, cdual);
+    SET_VECTOR_ELT(out, 2, rprim);
+    SET_VECTOR_ELT(out, 3, rdual);
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 4));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("colPrim"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("colDual"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("rowPrim"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("rowDual"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    UNPROTECT(6);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve column value for all columns (MIP) */
-SEXP mipColsVal(SEXP lp) {
+/* find (and delete) linearly dependent equality rows */
+SEXP findDepRows(SEXP lp, SEXP tol, SEXP del) {
+
+    SEXP out   = R_NilValue;
+    SEXP listv = R_NilValue;
+    SEXP rows, cons, res, base, coef, bk, ck, rowmap = R_NilValue;
+    glp_prob *P;
+    glpkDepend dp;
+    int *rm = NULL, *dep, *cs, *lbeg, *lind;
+    double *rs, *lval;
+    double mem0;
+    int k, t, nr = 0, ndep, nl, neq, rank, ret, err = 0;
+
+    checkProb(lp);
+
+    P = R_ExternalPtrAddr(lp);
+
+    if (Rf_asLogical(del) == TRUE) {
+        rm = (int *) R_alloc((size_t) glp_get_num_rows(P) + 1, sizeof(int));
+    }
+
+    mem0 = glpkMemTotal();
+    ret = glpkDependRows(P, Rf_asReal(tol), &dp);
+    if ( (ret == 0) && (rm != NULL) ) {
+        err = glpkDependDelete(P, &dp, rm, &nr);
+    }
+    memAccount(lp, mem0);
+
+    if ( (ret != 0) || (err != 0) ) {
+        glpkDependFree(&dp);
+        Rf_error("Out of memory!");
+    }
+
+    /* copy the result to memory released by R, no R object may be
+       allocated while dp is held */
+    ndep = dp.ndep;
+    nl   = dp.lbeg[ndep];
+    neq  = dp.neq;
+    rank = dp.rank;
+    dep  = (int *) R_alloc((size_t) ndep + 1, sizeof(int));
+    cs   = (int *) R_alloc((size_t) ndep + 1, sizeof(int));
+    rs   = (double *) R_alloc((size_t) ndep + 1, sizeof(double));
+    lbeg = (int *) R_alloc((size_t) ndep + 1, sizeof(int));
+    lind = (int *) R_alloc((size_t) nl + 1, sizeof(int));
+    lval = (double *) R_alloc((size_t) nl + 1, sizeof(double));
+    memcpy(dep, dp.dep, (size_t) ndep * sizeof(int));
+    memcpy(cs, dp.cons, (size_t) ndep * sizeof(int));
+    memcpy(rs, dp.res, (size_t) ndep * sizeof(double));
+    memcpy(lbeg, dp.lbeg, ((size_t) ndep + 1) * sizeof(int));
+    if (nl > 0) {
+        memcpy(lind, dp.lind, (size_t) nl * sizeof(int));
+        memcpy(lval, dp.lval, (size_t) nl * sizeof(double));
+    }
+    glpkDependFree(&dp);
+
+    PROTECT(rows = Rf_allocVector(INTSXP, ndep));
+    PROTECT(cons = Rf_allocVector(LGLSXP, ndep));
+    PROTECT(res  = Rf_allocVector(REALSXP, ndep));
+    PROTECT(base = Rf_allocVector(VECSXP, ndep));
+    PROTECT(coef = Rf_allocVector(VECSXP, ndep));
+
+    for (k = 0; k < ndep; k++) {
+        INTEGER(rows)[k] = dep[k];
+        LOGICAL(cons)[k] = cs[k];
+        REAL(res)[k]     = rs[k];
+        bk = Rf_allocVector(INTSXP, lbeg[k+1] - lbeg[k]);
+        SET_VECTOR_ELT(base, k, bk);
+        ck = Rf_allocVector(REALSXP, lbeg[k+1] - lbeg[k]);
+        SET_VECTOR_ELT(coef, k, ck);
+        for (t = lbeg[k]; t < lbeg[k+1]; t++) {
+            INTEGER(bk)[t - lbeg[k]] = lind[t];
+            REAL(ck)[t - lbeg[k]]    = lval[t];
+        }
+    }
+
+    if (rm != NULL) {
+        rowmap = Rf_allocVector(INTSXP, nr);
+        for (k = 0; k < nr; k++) {
+            INTEGER(rowmap)[k] = rm[k];
+        }
+    }
+    PROTECT(rowmap);
+
+    PROTECT(out = Rf_allocVector(VECSXP, 6));
+    SET_VECTOR_ELT(out, 0, rows);
+    SET_VECTOR_ELT(out, 1, cons);
+    SET_VECTOR_ELT(out, 2, res);
+    SET_VECTOR_ELT(out, 3, base);
+    SET_VECTOR_ELT(out, 4, coef);
+    SET_VECTOR_ELT(out, 5, rowmap);
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 6));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("rows"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("consistent"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("residual"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("base"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("coef"));
+    SET_STRING_ELT(listv, 5, Rf_mkChar("rowmap"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    Rf_setAttrib(out, Rf_install("neq"), Rf_ScalarInteger(neq));
+    Rf_setAttrib(out, Rf_install("rank"), Rf_ScalarInteger(rank));
+
+    UNPROTECT(8);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get value of the objective function after interior point method */
+SEXP getObjValIpt(SEXP lp) {
 
     SEXP out = R_NilValue;
-    double col = 0;
+    double obj_val = 0;
+
+    checkProb(lp);
+
+    obj_val = glp_ipt_obj_val(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarReal(obj_val);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get solution status after interior point method */
+SEXP getSolStatIpt(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int stat = 0;
+
+    checkProb(lp);
+
+    stat = glp_ipt_status(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(stat);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get column primal value (flux distribution) for all columns (interior) */
+SEXP getColsPrimIpt(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double col_prim = 0;
 
     int num_cols, k;
 
@@ -2928,8 +3530,8 @@ SEXP mipColsVal(SEXP lp) {
 
     PROTECT(out = Rf_allocVector(REALSXP, num_cols));
     for (k = 1; k <= num_cols; k++) {
-        col = glp_mip_col_val(R_ExternalPtrAddr(lp), k);
-        REAL(out)[k-1] = col;
+        col_prim = glp_ipt_col_prim(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = col_prim;
     }
     UNPROTECT(1);
 
@@ -2938,962 +3540,2219 @@ SEXP mipColsVal(SEXP lp) {
 
 
 /* -------------------------------------------------------------------------- */
-/* get the number of constraint coefficients (number of non-zero elements in
-   the consrtaint matrix) */
-SEXP getNumNnz(SEXP lp) {
+/* get column primal value (flux distribution) for one column (interior) */
+SEXP getColPrimIpt(SEXP lp, SEXP j) {
 
     SEXP out = R_NilValue;
-    int nnz = 0;
+    double col_prim = 0;
 
     checkProb(lp);
+    checkColIndex(lp, j);
 
-    nnz = glp_get_num_nz(R_ExternalPtrAddr(lp));
+    col_prim = glp_ipt_col_prim(R_ExternalPtrAddr(lp), Rf_asInteger(j));
 
-    out = Rf_ScalarInteger(nnz);
+    out = Rf_ScalarReal(col_prim);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* get row i of the contraint matrix */
-SEXP getMatRow(SEXP lp, SEXP i) {
-
-    SEXP out   = R_NilValue;
-    SEXP ind   = R_NilValue;
-    SEXP val   = R_NilValue;
-    SEXP listv = R_NilValue;
+/* retrieve row primal value (interior) */
+SEXP getRowPrimIpt(SEXP lp, SEXP i) {
 
-    int nnzr = 0;
+    SEXP out = R_NilValue;
+    double row_prim = 0;
 
     checkProb(lp);
     checkRowIndex(lp, i);
 
-    nnzr = glp_get_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i), NULL, NULL);
+    row_prim = glp_ipt_row_prim(R_ExternalPtrAddr(lp), Rf_asInteger(i));
 
-    if (nnzr > 0) {
-        PROTECT(ind = Rf_allocVector(INTSXP,  nnzr+1));
-        PROTECT(val = Rf_allocVector(REALSXP, nnzr+1));
+    out = Rf_ScalarReal(row_prim);
 
-        nnzr = glp_get_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i),
-                               INTEGER(ind), REAL(val)
-               );
+    return out;
+}
 
-        /* maybe this is ugly */
-        REAL(val)[0] = 0;
-        INTEGER(ind)[0] = 0;
 
-        PROTECT(out = Rf_allocVector(VECSXP, 3));
-        SET_VECTOR_ELT(out, 0, Rf_ScalarInteger(nnzr));
-        SET_VECTOR_ELT(out, 1, ind);
-        SET_VECTOR_ELT(out, 2, val);
+/* -------------------------------------------------------------------------- */
+/* retrieve row primal value (interior) for all rows (interior) */
+SEXP getRowsPrimIpt(SEXP lp) {
 
-        PROTECT(listv = Rf_allocVector(STRSXP, 3));
-        SET_STRING_ELT(listv, 0, Rf_mkChar("nnz"));
-        SET_STRING_ELT(listv, 1, Rf_mkChar("index"));
-        SET_STRING_ELT(listv, 2, Rf_mkChar("value"));
-        Rf_setAttrib(out, R_NamesSymbol, listv);
+    SEXP out = R_NilValue;
+    double row_prim = 0;
 
-        UNPROTECT(4);
+    int num_rows, k;
+
+    checkProb(lp);
+
+    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
+
+    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
+    for (k = 1; k <= num_rows; k++) {
+        row_prim = glp_ipt_row_prim(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = row_prim;
     }
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* set row i of the contraint matrix */
-SEXP setMatRow(SEXP lp, SEXP i, SEXP len, SEXP ind, SEXP val) {
+/* retrieve row dual value (interior) */
+SEXP getRowDualIpt(SEXP lp, SEXP i) {
 
-    SEXP out   = R_NilValue;
+    SEXP out = R_NilValue;
+    double row_dual = 0;
 
-    int *rind;
-    double *rval;
+    checkProb(lp);
+    checkRowIndex(lp, i);
 
-    if (ind == R_NilValue) {
-        rind = NULL;
-    }
-    else {
-        rind = INTEGER(ind);
-    }
+    row_dual = glp_ipt_row_dual(R_ExternalPtrAddr(lp), Rf_asInteger(i));
 
-    if (val == R_NilValue) {
-        rval = NULL;
-    }
-    else {
-        rval = REAL(val);
+    out = Rf_ScalarReal(row_dual);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve row dual value (interior) for all rows (interior) */
+SEXP getRowsDualIpt(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double row_dual = 0;
+
+    int num_rows, k;
+
+    checkProb(lp);
+
+    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
+
+    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
+    for (k = 1; k <= num_rows; k++) {
+        row_dual = glp_ipt_row_dual(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = row_dual;
     }
+    UNPROTECT(1);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve column dual value (interior) */
+SEXP getColDualIpt(SEXP lp, SEXP j) {
+
+    SEXP out = R_NilValue;
+    double col_dual = 0;
 
     checkProb(lp);
-    checkRowIndex(lp, i);
-    checkColIndices(lp, ind, 1);
+    checkColIndex(lp, j);
+
+    col_dual = glp_ipt_col_dual(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+
+    out = Rf_ScalarReal(col_dual);
+
+    return out;
+}
 
-    glp_set_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i),
-                    Rf_asInteger(len), rind, rval
-                   );
+
+/* -------------------------------------------------------------------------- */
+/* retrieve column dual value (interior) for all columns (interior) */
+SEXP getColsDualIpt(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double col_dual = 0;
+
+    int num_cols, k;
+
+    checkProb(lp);
+
+    num_cols = glp_get_num_cols(R_ExternalPtrAddr(lp));
+
+    PROTECT(out = Rf_allocVector(REALSXP, num_cols));
+    for (k = 1; k <= num_cols; k++) {
+        col_dual = glp_ipt_col_dual(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = col_dual;
+    }
+    UNPROTECT(1);
 
     return out;
 }
 
 
-/* -------------------------------------------------------------------------- */
-/* get column j of the contraint matrix */
-SEXP getMatCol(SEXP lp, SEXP j) {
+/* -------------------------------------------------------------------------- */
+/* solve MIP problem with the branch-and-cut method */
+SEXP solveMIP(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double mem0;
+    int ret = 0;
+
+    checkProb(lp);
+
+    mem0 = glpkMemTotal();
+    ret = glpkSolveMIP(R_ExternalPtrAddr(lp), &parmM, probInfo(lp, 1));
+    memAccount(lp, mem0);
+
+    out = Rf_ScalarInteger(ret);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* determine status of MIP solution */
+SEXP mipStatus(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int stat = 0;
+
+    checkProb(lp);
+
+    stat = glp_mip_status(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(stat);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve objective value */
+SEXP mipObjVal(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double obj_val = 0;
+
+    checkProb(lp);
+
+    obj_val = glp_mip_obj_val(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarReal(obj_val);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve row value (MIP) */
+SEXP mipRowVal(SEXP lp, SEXP i) {
+
+    SEXP out = R_NilValue;
+    double row = 0;
+
+    checkProb(lp);
+    checkRowIndex(lp, i);
+
+    row = glp_mip_row_val(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+
+    out = Rf_ScalarReal(row);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve row value for all rows (MIP) */
+SEXP mipRowsVal(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double row = 0;
+
+    int num_rows, k;
+
+    checkProb(lp);
+
+    num_rows = glp_get_num_rows(R_ExternalPtrAddr(lp));
+
+    PROTECT(out = Rf_allocVector(REALSXP, num_rows));
+    for (k = 1; k <= num_rows; k++) {
+        row = glp_mip_row_val(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = row;
+    }
+    UNPROTECT(1);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve column value (MIP) */
+SEXP mipColVal(SEXP lp, SEXP j) {
+
+    SEXP out = R_NilValue;
+    double col = 0;
+
+    checkProb(lp);
+    checkColIndex(lp, j);
+
+    col = glp_mip_col_val(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+
+    out = Rf_ScalarReal(col);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* retrieve column value for all columns (MIP) */
+SEXP mipColsVal(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    double col = 0;
+
+    int num_cols, k;
+
+    checkProb(lp);
+
+    num_cols = glp_get_num_cols(R_ExternalPtrAddr(lp));
+
+    PROTECT(out = Rf_allocVector(REALSXP, num_cols));
+    for (k = 1; k <= num_cols; k++) {
+        col = glp_mip_col_val(R_ExternalPtrAddr(lp), k);
+        REAL(out)[k-1] = col;
+    }
+    UNPROTECT(1);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get the number of constraint coefficients (number of non-zero elements in
+   the consrtaint matrix) */
+SEXP getNumNnz(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int nnz = 0;
+
+    checkProb(lp);
+
+    nnz = glp_get_num_nz(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(nnz);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get row i of the contraint matrix */
+SEXP getMatRow(SEXP lp, SEXP i) {
+
+    SEXP out   = R_NilValue;
+    SEXP ind   = R_NilValue;
+    SEXP val   = R_NilValue;
+    SEXP listv = R_NilValue;
+
+    int nnzr = 0;
+
+    checkProb(lp);
+    checkRowIndex(lp, i);
+
+    nnzr = glp_get_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i), NULL, NULL);
+
+    if (nnzr > 0) {
+        PROTECT(ind = Rf_allocVector(INTSXP,  nnzr+1));
+        PROTECT(val = Rf_allocVector(REALSXP, nnzr+1));
+
+        nnzr = glp_get_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i),
+                               INTEGER(ind), REAL(val)
+               );
+
+        /* maybe this is ugly */
+        REAL(val)[0] = 0;
+        INTEGER(ind)[0] = 0;
+
+        PROTECT(out = Rf_allocVector(VECSXP, 3));
+        SET_VECTOR_ELT(out, 0, Rf_ScalarInteger(nnzr));
+        SET_VECTOR_ELT(out, 1, ind);
+        SET_VECTOR_ELT(out, 2, val);
+
+        PROTECT(listv = Rf_allocVector(STRSXP, 3));
+        SET_STRING_ELT(listv, 0, Rf_mkChar("nnz"));
+        SET_STRING_ELT(listv, 1, Rf_mkChar("index"));
+        SET_STRING_ELT(listv, 2, Rf_mkChar("value"));
+        Rf_setAttrib(out, R_NamesSymbol, listv);
+
+        UNPROTECT(4);
+    }
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* set row i of the contraint matrix */
+SEXP setMatRow(SEXP lp, SEXP i, SEXP len, SEXP ind, SEXP val) {
+
+    SEXP out   = R_NilValue;
+
+    int *rind;
+    double *rval;
+
+    if (ind == R_NilValue) {
+        rind = NULL;
+    }
+    else {
+        rind = INTEGER(ind);
+    }
+
+    if (val == R_NilValue) {
+        rval = NULL;
+    }
+    else {
+        rval = REAL(val);
+    }
+
+    checkProb(lp);
+    checkRowIndex(lp, i);
+    checkColIndices(lp, ind, 1);
+
+    glp_set_mat_row(R_ExternalPtrAddr(lp), Rf_asInteger(i),
+                    Rf_asInteger(len), rind, rval
+                   );
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get column j of the contraint matrix */
+SEXP getMatCol(SEXP lp, SEXP j) {
+
+    SEXP out   = R_NilValue;
+    SEXP ind   = R_NilValue;
+    SEXP val   = R_NilValue;
+    SEXP listv = R_NilValue;
+
+    int nnzc = 0;
+
+    checkProb(lp);
+    checkColIndex(lp, j);
+
+    nnzc = glp_get_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j), NULL, NULL);
+
+    if (nnzc > 0) {
+        PROTECT(ind = Rf_allocVector(INTSXP,  nnzc+1));
+        PROTECT(val = Rf_allocVector(REALSXP, nnzc+1));
+
+        nnzc = glp_get_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j),
+                               INTEGER(ind), REAL(val)
+                               );
+
+        /* maybe this is ugly */
+        REAL(val)[0] = 0;
+        INTEGER(ind)[0] = 0;
+
+        PROTECT(out = Rf_allocVector(VECSXP, 3));
+        SET_VECTOR_ELT(out, 0, Rf_ScalarInteger(nnzc));
+        SET_VECTOR_ELT(out, 1, ind);
+        SET_VECTOR_ELT(out, 2, val);
+
+        PROTECT(listv = Rf_allocVector(STRSXP, 3));
+        SET_STRING_ELT(listv, 0, Rf_mkChar("nnz"));
+        SET_STRING_ELT(listv, 1, Rf_mkChar("index"));
+        SET_STRING_ELT(listv, 2, Rf_mkChar("value"));
+        Rf_setAttrib(out, R_NamesSymbol, listv);
+
+        UNPROTECT(4);
+    }
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* set column j of the contraint matrix */
+SEXP setMatCol(SEXP lp, SEXP j, SEXP len, SEXP ind, SEXP val) {
+
+    SEXP out   = R_NilValue;
+
+    const int *rind;
+    const double *rval;
+
+    if (ind == R_NilValue) {
+        rind = NULL;
+    }
+    else {
+        rind = INTEGER(ind);
+    }
+
+    if (val == R_NilValue) {
+        rval = NULL;
+    }
+    else {
+        rval = REAL(val);
+    }
+
+    checkProb(lp);
+    checkColIndex(lp, j);
+    checkRowIndices(lp, ind, 1);
+
+    glp_set_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j),
+                    Rf_asInteger(len), rind, rval
+                   );
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read problem data in MPS format */
+SEXP readMPS(SEXP lp, SEXP fmt, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    double mem0;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+    int fm;
+
+    checkProb(lp);
+
+    fm = (Rf_asInteger(fmt) == GLP_MPS_DECK) ? GLP_MPS_DECK : GLP_MPS_FILE;
+
+    mem0 = glpkMemTotal();
+    check = glp_read_mps(R_ExternalPtrAddr(lp), fm, NULL, rfname);
+    memAccount(lp, mem0);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read problem data in CPLEX LP format */
+SEXP readLP(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    double mem0;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    mem0 = glpkMemTotal();
+    check = glp_read_lp(R_ExternalPtrAddr(lp), NULL, rfname);
+    memAccount(lp, mem0);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read problem data in GLPK format */
+SEXP readProb(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    double mem0;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+    int flags = 0;
+
+    checkProb(lp);
+
+    mem0 = glpkMemTotal();
+    check = glp_read_prob(R_ExternalPtrAddr(lp), flags, rfname);
+    memAccount(lp, mem0);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write problem data in MPS format */
+SEXP writeMPS(SEXP lp, SEXP fmt, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+    int fm;
+
+    checkProb(lp);
+
+    fm = (Rf_asInteger(fmt) == GLP_MPS_DECK) ? GLP_MPS_DECK : GLP_MPS_FILE;
+
+    check = glp_write_mps(R_ExternalPtrAddr(lp), fm, NULL, rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write problem data in CPLEX LP format */
+SEXP writeLP(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_write_lp(R_ExternalPtrAddr(lp), NULL, rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write problem data in GLPK format */
+SEXP writeProb(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+    int flags = 0;
+
+    checkProb(lp);
+
+    check = glp_write_prob(R_ExternalPtrAddr(lp), flags, rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write basic solution in printable format */
+SEXP printSol(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_print_sol(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read basic solution from text file */
+SEXP readSol(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_read_sol(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write basic solution to text file */
+SEXP writeSol(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_write_sol(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write interior-point solution in printable format */
+SEXP printIpt(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_print_ipt(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read interior-point solution from text file */
+SEXP readIpt(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_read_ipt(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write interior-point solution to text file */
+SEXP writeIpt(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_write_ipt(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write MIP solution in printable format */
+SEXP printMIP(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_print_mip(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* read MIP solution from text file */
+SEXP readMIP(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_read_mip(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* write MIP solution to text file */
+SEXP writeMIP(SEXP lp, SEXP fname) {
+
+    SEXP out = R_NilValue;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    int check = 0;
+
+    checkProb(lp);
+
+    check = glp_write_mip(R_ExternalPtrAddr(lp), rfname);
+
+    out = Rf_ScalarInteger(check);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* determine library version */
+SEXP version() {
+
+    SEXP out = R_NilValue;
+
+    const char *vstr = glp_version();
+
+    out = Rf_mkString(vstr);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* check if the basis factorization exists */
+SEXP bfExists(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int bex = 0;
+
+    checkProb(lp);
+
+    bex = glp_bf_exists(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(bex);
+
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* compute the basis factorization */
+SEXP factorize(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int fex = 0;
+
+    checkProb(lp);
+
+    fex = glp_factorize(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(fex);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* check if the basis factorization has been updated */
+SEXP bfUpdated(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    int bup = 0;
+
+    checkProb(lp);
+
+    bup = glp_bf_updated(R_ExternalPtrAddr(lp));
+
+    out = Rf_ScalarInteger(bup);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* change basis factorization control parameters */
+SEXP setBfcp(SEXP lp, SEXP npari, SEXP pari, SEXP vali,
+                      SEXP npard, SEXP pard, SEXP vald) {
+
+    SEXP out   = R_NilValue;
+
+    glp_bfcp parmB;
+
+    int *rpari;
+    int *rvali;
+
+    int *rpard;
+    double *rvald;
+
+    int i, d;
+
+    checkProb(lp);
+
+    /* get current values of control parameters */
+    glp_get_bfcp(R_ExternalPtrAddr(lp), &parmB);
+
+    if (Rf_asInteger(npari) == 0) {
+        rpari = NULL;
+        rvali = NULL;
+    }
+    else {
+        rpari = INTEGER(pari);
+        rvali = INTEGER(vali);
+
+        for (i = 0; i < Rf_asInteger(npari); i++) {
+            /* Rprintf("par: %i  val: %i\n", rpari[i], rvali[i]); */
+            switch (rpari[i]) {
+                case 401:
+                    parmB.type = rvali[i];
+                    break;
+                case 402:
+                    parmB.lu_size = rvali[i];
+                    break;
+                case 403:
+                    parmB.piv_lim = rvali[i];
+                    break;
+                case 404:
+                    parmB.suhl = rvali[i];
+                    break;
+                case 405:
+                    parmB.nfs_max = rvali[i];
+                    break;
+                case 406:
+                    parmB.nrs_max = rvali[i];
+                    break;
+                case 407:
+                    parmB.rs_size = rvali[i];
+                    break;
+                default:
+                    Rf_warning("Unknown integer basis factorization parameter: %i!", rpari[i]);
+                    break;
+            }
+        }
+
+    }
+
+    if (Rf_asInteger(npard) == 0) {
+        rpard = NULL;
+        rvald = NULL;
+    }
+    else {
+        rpard = INTEGER(pard);
+        rvald = REAL(vald);
+
+        for (d = 0; d < Rf_asInteger(npard); d++) {
+            /* Rprintf("par: %i  val: %i\n", rpard[d], rvald[d]); */
+            switch (rpard[d]) {
+                case 501:
+                    parmB.piv_tol = rvald[d];
+                    break;
+                case 502:
+                    parmB.eps_tol = rvald[d];
+                    break;
+                case 503:
+                    parmB.max_gro = rvald[d];
+                    break;
+                case 504:
+                    parmB.upd_tol = rvald[d];
+                    break;
+                default:
+                    Rf_warning("Unknown double basis factorization parameter: %i!", rpard[d]);
+                    break;
+            }
+        }
+
+    }
+
+    /* set new values of control parameters */
+    glp_set_bfcp(R_ExternalPtrAddr(lp), &parmB);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get basis factorization control parameters */
+SEXP getBfcp(SEXP lp) {
+
+    glp_bfcp parmB;
+
+    SEXP listv   = R_NilValue;
+    SEXP parmext = R_NilValue;
+    SEXP intids  = R_NilValue;
+    SEXP dbids   = R_NilValue;
+
+    SEXP pint  = R_NilValue;
+    SEXP pdb   = R_NilValue;
+
+    /* get current values of control parameters */
+    glp_get_bfcp(R_ExternalPtrAddr(lp), &parmB);
+
+    PROTECT(pint = Rf_allocVector(INTSXP, 7));
+    PROTECT(pdb  = Rf_allocVector(REALSXP, 4));
+
+    INTEGER(pint)[0] = parmB.type;
+    INTEGER(pint)[1] = parmB.lu_size;
+    INTEGER(pint)[2] = parmB.piv_lim;
+    INTEGER(pint)[3] = parmB.suhl;
+    INTEGER(pint)[4] = parmB.nfs_max;
+    INTEGER(pint)[5] = parmB.nrs_max;
+    INTEGER(pint)[6] = parmB.rs_size;
+
+    REAL(pdb)[0] = parmB.piv_tol;
+    REAL(pdb)[1] = parmB.eps_tol;
+    REAL(pdb)[2] = parmB.max_gro;
+    REAL(pdb)[3] = parmB.upd_tol;
+
+    PROTECT(intids = Rf_allocVector(STRSXP, 7));
+    SET_STRING_ELT(intids, 0, Rf_mkChar("type"));
+    SET_STRING_ELT(intids, 1, Rf_mkChar("lu_size"));
+    SET_STRING_ELT(intids, 2, Rf_mkChar("piv_lim"));
+    SET_STRING_ELT(intids, 3, Rf_mkChar("suhl"));
+    SET_STRING_ELT(intids, 4, Rf_mkChar("nfs_max"));
+    SET_STRING_ELT(intids, 5, Rf_mkChar("nrs_max"));
+    SET_STRING_ELT(intids, 6, Rf_mkChar("rs_size"));
+
+    PROTECT(dbids = Rf_allocVector(STRSXP, 4));
+    SET_STRING_ELT(dbids, 0, Rf_mkChar("piv_tol"));
+    SET_STRING_ELT(dbids, 1, Rf_mkChar("eps_tol"));
+    SET_STRING_ELT(dbids, 2, Rf_mkChar("max_gro"));
+    SET_STRING_ELT(dbids, 3, Rf_mkChar("upd_tol"));
+
+    Rf_setAttrib(pint, R_NamesSymbol, intids);
+    Rf_setAttrib(pdb, R_NamesSymbol, dbids);
+
+    PROTECT(parmext = Rf_allocVector(VECSXP, 2));
+    SET_VECTOR_ELT(parmext, 0, pint);
+    SET_VECTOR_ELT(parmext, 1, pdb);
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 2));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("integer"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("double"));
 
-    SEXP out   = R_NilValue;
-    SEXP ind   = R_NilValue;
-    SEXP val   = R_NilValue;
-    SEXP listv = R_NilValue;
+    Rf_setAttrib(parmext, R_NamesSymbol, listv);
 
-    int nnzc = 0;
+    UNPROTECT(6);
 
-    checkProb(lp);
-    checkColIndex(lp, j);
+    return parmext;
 
-    nnzc = glp_get_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j), NULL, NULL);
+}
 
-    if (nnzc > 0) {
-        PROTECT(ind = Rf_allocVector(INTSXP,  nnzc+1));
-        PROTECT(val = Rf_allocVector(REALSXP, nnzc+1));
 
-        nnzc = glp_get_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j),
-                               INTEGER(ind), REAL(val)
-                               );
+/* -------------------------------------------------------------------------- */
+/* retrieve basis header information */
+SEXP getBhead(SEXP lp, SEXP k) {
 
-        /* maybe this is ugly */
-        REAL(val)[0] = 0;
-        INTEGER(ind)[0] = 0;
+    SEXP out = R_NilValue;
+    int bh;
 
-        PROTECT(out = Rf_allocVector(VECSXP, 3));
-        SET_VECTOR_ELT(out, 0, Rf_ScalarInteger(nnzc));
-        SET_VECTOR_ELT(out, 1, ind);
-        SET_VECTOR_ELT(out, 2, val);
+    checkProb(lp);
 
-        PROTECT(listv = Rf_allocVector(STRSXP, 3));
-        SET_STRING_ELT(listv, 0, Rf_mkChar("nnz"));
-        SET_STRING_ELT(listv, 1, Rf_mkChar("index"));
-        SET_STRING_ELT(listv, 2, Rf_mkChar("value"));
-        Rf_setAttrib(out, R_NamesSymbol, listv);
+    bh = glp_get_bhead(R_ExternalPtrAddr(lp), Rf_asInteger(k));
 
-        UNPROTECT(4);
-    }
+    out = Rf_ScalarInteger(bh);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* set column j of the contraint matrix */
-SEXP setMatCol(SEXP lp, SEXP j, SEXP len, SEXP ind, SEXP val) {
-
-    SEXP out   = R_NilValue;
-
-    const int *rind;
-    const double *rval;
-
-    if (ind == R_NilValue) {
-        rind = NULL;
-    }
-    else {
-        rind = INTEGER(ind);
-    }
+/* retrieve row index in the basis header */
+SEXP getRbind(SEXP lp, SEXP i) {
 
-    if (val == R_NilValue) {
-        rval = NULL;
-    }
-    else {
-        rval = REAL(val);
-    }
+    SEXP out = R_NilValue;
+    int rh;
 
     checkProb(lp);
-    checkColIndex(lp, j);
-    checkRowIndices(lp, ind, 1);
+    checkRowIndex(lp, i);
 
-    glp_set_mat_col(R_ExternalPtrAddr(lp), Rf_asInteger(j),
-                    Rf_asInteger(len), rind, rval
-                   );
+    rh = glp_get_row_bind(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+
+    out = Rf_ScalarInteger(rh);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read problem data in MPS format */
-SEXP readMPS(SEXP lp, SEXP fmt, SEXP fname) {
+/* retrieve column index in the basis header */
+SEXP getCbind(SEXP lp, SEXP j) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
-    int fm;
+    int ch;
 
     checkProb(lp);
+    checkColIndex(lp, j);
 
-    fm = (Rf_asInteger(fmt) == GLP_MPS_DECK) ? GLP_MPS_DECK : GLP_MPS_FILE;
-
-    check = glp_read_mps(R_ExternalPtrAddr(lp), fm, NULL, rfname);
+    ch = glp_get_col_bind(R_ExternalPtrAddr(lp), Rf_asInteger(j));
 
-    out = Rf_ScalarInteger(check);
+    out = Rf_ScalarInteger(ch);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read problem data in CPLEX LP format */
-SEXP readLP(SEXP lp, SEXP fname) {
+/* print sensitivity analysis report */
+SEXP printRanges(SEXP lp, SEXP numrc, SEXP rowcol, SEXP fname) {
 
     SEXP out = R_NilValue;
+
+    const int *rrowcol;
     const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
+    int sensit;
+
+    if (rowcol == R_NilValue) {
+        rrowcol = NULL;
+    }
+    else {
+        rrowcol = INTEGER(rowcol);
+    }
 
     checkProb(lp);
 
-    check = glp_read_lp(R_ExternalPtrAddr(lp), NULL, rfname);
+    sensit = glp_print_ranges(R_ExternalPtrAddr(lp), Rf_asInteger(numrc),
+                              rrowcol, 0, rfname
+                             );
 
-    out = Rf_ScalarInteger(check);
+    out = Rf_ScalarInteger(sensit);
 
     return out;
+
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read problem data in GLPK format */
-SEXP readProb(SEXP lp, SEXP fname) {
+/* allocate translator workspace */
+SEXP mplAllocWksp(SEXP ptrtype) {
 
-    SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
-    int flags = 0;
+    SEXP wkext = R_NilValue;
+    SEXP ptr, class;
+    
+    glp_tran *wk;
 
-    checkProb(lp);
+    /* create translator workspace pointer */
+    PROTECT(ptr = Rf_allocVector(STRSXP, 1));
+    SET_STRING_ELT(ptr, 0, STRING_ELT(ptrtype, 0));
 
-    check = glp_read_prob(R_ExternalPtrAddr(lp), flags, rfname);
+    PROTECT(class = Rf_allocVector(STRSXP, 1));
+    SET_STRING_ELT(class, 0, Rf_mkChar("trwks_ptr"));
 
-    out = Rf_ScalarInteger(check);
+    wk = glp_mpl_alloc_wksp();
 
-    return out;
+    wkext = R_MakeExternalPtr(wk, tagMATHprog, R_NilValue);
+    PROTECT(wkext);
+    R_RegisterCFinalizerEx(wkext, mathProgFinalizer, TRUE);
+    Rf_setAttrib(ptr, class, wkext);
+    Rf_classgets(ptr, class);
+    UNPROTECT(3);
+
+    return ptr;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write problem data in MPS format */
-SEXP writeMPS(SEXP lp, SEXP fmt, SEXP fname) {
+/* free translator workspace */
+SEXP mplFreeWksp(SEXP wksp) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
-    int fm;
-
-    checkProb(lp);
+    glp_tran *delwk = NULL;
 
-    fm = (Rf_asInteger(fmt) == GLP_MPS_DECK) ? GLP_MPS_DECK : GLP_MPS_FILE;
+    checkMathProg(wksp);
 
-    check = glp_write_mps(R_ExternalPtrAddr(lp), fm, NULL, rfname);
+    delwk = R_ExternalPtrAddr(wksp);
 
-    out = Rf_ScalarInteger(check);
+    glp_mpl_free_wksp(delwk);
+    R_ClearExternalPtr(wksp);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write problem data in CPLEX LP format */
-SEXP writeLP(SEXP lp, SEXP fname) {
+/* read and translate model section */
+SEXP mplReadModel(SEXP wk, SEXP fname, SEXP skip) {
 
     SEXP out = R_NilValue;
     const char *rfname = CHAR(STRING_ELT(fname, 0));
     int check = 0;
 
-    checkProb(lp);
+    checkMathProg(wk);
 
-    check = glp_write_lp(R_ExternalPtrAddr(lp), NULL, rfname);
+    if ( setjmp(jenv) ) {
+        glpkGuardHook();
+        return out;
+    }
 
-    out = Rf_ScalarInteger(check);
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
+
+    check = glp_mpl_read_model(R_ExternalPtrAddr(wk),
+                               rfname, Rf_asInteger(skip));
+
+    glpkGuardHook();
+    
+    if (check != 0) {
+        out = Rf_ScalarInteger(check);
+    }
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write problem data in GLPK format */
-SEXP writeProb(SEXP lp, SEXP fname) {
+/* read and translate data section */
+SEXP mplReadData(SEXP wk, SEXP fname) {
 
     SEXP out = R_NilValue;
     const char *rfname = CHAR(STRING_ELT(fname, 0));
     int check = 0;
-    int flags = 0;
 
-    checkProb(lp);
+    checkMathProg(wk);
 
-    check = glp_write_prob(R_ExternalPtrAddr(lp), flags, rfname);
+    if ( setjmp(jenv) ) {
+        glpkGuardHook();
+        return out;
+    }
 
-    out = Rf_ScalarInteger(check);
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
+
+    check = glp_mpl_read_data(R_ExternalPtrAddr(wk), rfname);
+
+    glpkGuardHook();
+
+    if (check != 0) {
+        out = Rf_ScalarInteger(check);
+    }
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write basic solution in printable format */
-SEXP printSol(SEXP lp, SEXP fname) {
+/* generate the model */
+SEXP mplGenerate(SEXP wk, SEXP fname) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    const char *rfname;
     int check = 0;
 
-    checkProb(lp);
+    checkMathProg(wk);
 
-    check = glp_print_sol(R_ExternalPtrAddr(lp), rfname);
+    if (fname == R_NilValue) {
+        rfname = NULL;
+    }
+    else {
+        rfname = CHAR(STRING_ELT(fname, 0));
+    }
 
-    out = Rf_ScalarInteger(check);
+    if ( setjmp(jenv) ) {
+        glpkGuardHook();
+        return out;
+    }
+
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
+
+    check = glp_mpl_generate(R_ExternalPtrAddr(wk), rfname);
+
+    glpkGuardHook();
+
+    if (check != 0) {
+        out = Rf_ScalarInteger(check);
+    }
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read basic solution from text file */
-SEXP readSol(SEXP lp, SEXP fname) {
+/* build problem instance from model */
+SEXP mplBuildProb(SEXP wk, SEXP lp) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
+    double mem0;
 
+    checkMathProg(wk);
     checkProb(lp);
 
-    check = glp_read_sol(R_ExternalPtrAddr(lp), rfname);
-
-    out = Rf_ScalarInteger(check);
+    mem0 = glpkMemTotal();
+    glp_mpl_build_prob(R_ExternalPtrAddr(wk), R_ExternalPtrAddr(lp));
+    memAccount(lp, mem0);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write basic solution to text file */
-SEXP writeSol(SEXP lp, SEXP fname) {
+/* postsolve model */
+SEXP mplPostsolve(SEXP wk, SEXP lp, SEXP sol) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
     int check = 0;
 
+    checkMathProg(wk);
     checkProb(lp);
+    checkSolType(sol);
 
-    check = glp_write_sol(R_ExternalPtrAddr(lp), rfname);
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
 
-    out = Rf_ScalarInteger(check);
+    check = glp_mpl_postsolve(R_ExternalPtrAddr(wk),
+                              R_ExternalPtrAddr(lp),
+                              Rf_asInteger(sol));
+
+    glpkGuardHook();
+
+    if (check != 0) {
+        out = Rf_ScalarInteger(check);
+    }
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write interior-point solution in printable format */
-SEXP printIpt(SEXP lp, SEXP fname) {
+/* configure cache of generated MathProg problems */
+SEXP mplSetCache(SEXP enable, SEXP dir, SEXP maxent) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
-
-    checkProb(lp);
+    const char *rdir;
 
-    check = glp_print_ipt(R_ExternalPtrAddr(lp), rfname);
+    if (dir == R_NilValue) {
+        rdir = NULL;
+    }
+    else {
+        rdir = CHAR(STRING_ELT(dir, 0));
+    }
 
-    out = Rf_ScalarInteger(check);
+    glpkCacheSetup(Rf_asLogical(enable) == TRUE, rdir, Rf_asInteger(maxent));
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read interior-point solution from text file */
-SEXP readIpt(SEXP lp, SEXP fname) {
+/* get state of the cache of generated MathProg problems */
+SEXP mplGetCache(void) {
 
-    SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
 
-    checkProb(lp);
+    int entries;
+    double bytes, hits, misses;
+    const char *dir;
 
-    check = glp_read_ipt(R_ExternalPtrAddr(lp), rfname);
+    glpkCacheInfo(&entries, &bytes, &hits, &misses, &dir);
 
-    out = Rf_ScalarInteger(check);
+    PROTECT(out = Rf_allocVector(VECSXP, 6));
+    SET_VECTOR_ELT(out, 0, Rf_ScalarLogical(glpkCacheEnabled()));
+    SET_VECTOR_ELT(out, 1, (dir == NULL) ? R_NilValue : Rf_mkString(dir));
+    SET_VECTOR_ELT(out, 2, Rf_ScalarInteger(entries));
+    SET_VECTOR_ELT(out, 3, Rf_ScalarReal(bytes));
+    SET_VECTOR_ELT(out, 4, Rf_ScalarReal(hits));
+    SET_VECTOR_ELT(out, 5, Rf_ScalarReal(misses));
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 6));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("enabled"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("dir"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("entries"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("bytes"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("hits"));
+    SET_STRING_ELT(listv, 5, Rf_mkChar("misses"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    UNPROTECT(2);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write interior-point solution to text file */
-SEXP writeIpt(SEXP lp, SEXP fname) {
+/* remove all problems from the cache of generated MathProg problems */
+SEXP mplClearCache(SEXP disk) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
 
-    checkProb(lp);
-
-    check = glp_write_ipt(R_ExternalPtrAddr(lp), rfname);
-
-    out = Rf_ScalarInteger(check);
+    glpkCacheClear(Rf_asLogical(disk) == TRUE);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write MIP solution in printable format */
-SEXP printMIP(SEXP lp, SEXP fname) {
+/* build problem instance from model and data files, using the cache */
+SEXP mplCachedProb(SEXP lp, SEXP model, SEXP data, SEXP skip, SEXP salt) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    const char *rmodel = CHAR(STRING_ELT(model, 0));
+    const char *gver = glp_version();
+    const unsigned char *snap = NULL;
+    glp_prob *prob = NULL;
+    glp_tran * volatile tran = NULL;
+    glpkBuf buf = { NULL, 0, 0 };
+    glpkHash hv;
+    char key[GLPK_CACHE_KEYLEN + 1];
+    size_t slen = 0;
+    int ndata = (data == R_NilValue) ? 0 : Rf_length(data);
+    int nsalt = (salt == R_NilValue) ? 0 : Rf_length(salt);
+    int rskip = Rf_asInteger(skip);
+    int sver = GLPK_SNAP_VERSION;
     int check = 0;
+    int k;
+    size_t len;
 
     checkProb(lp);
 
-    check = glp_print_mip(R_ExternalPtrAddr(lp), rfname);
+    prob = R_ExternalPtrAddr(lp);
 
-    out = Rf_ScalarInteger(check);
+    if (glpkCacheEnabled()) {
+        /* the key covers everything which changes the generated problem */
+        glpkHashInit(&hv);
+        glpkHashBytes(&hv, gver, strlen(gver));
+        glpkHashBytes(&hv, &sver, sizeof(int));
+        glpkHashBytes(&hv, &rskip, sizeof(int));
+        if (glpkHashFile(&hv, rmodel) != 0) {
+            Rf_error("Can not read model file '%s'!", rmodel);
+        }
+        glpkHashBytes(&hv, &ndata, sizeof(int));
+        for (k = 0; k < ndata; k++) {
+            if (glpkHashFile(&hv, CHAR(STRING_ELT(data, k))) != 0) {
+                Rf_error("Can not read data file '%s'!",
+                         CHAR(STRING_ELT(data, k)));
+            }
+        }
+        /* files read by table statements are not known here, the caller
+           may describe them in salt */
+        glpkHashBytes(&hv, &nsalt, sizeof(int));
+        for (k = 0; k < nsalt; k++) {
+            len = strlen(CHAR(STRING_ELT(salt, k)));
+            glpkHashBytes(&hv, CHAR(STRING_ELT(salt, k)), len);
+            glpkHashBytes(&hv, &len, sizeof(len));
+        }
+        glpkHashKey(hv, key);
 
-    return out;
-}
+        snap = glpkCacheLookup(key, &slen);
+        if (snap != NULL) {
+            if (glpkSnapRead(prob, snap, slen) == 0) {
+                out = Rf_ScalarLogical(1);
+                return out;
+            }
+            /* damaged entry, build the problem again */
+            glpkCacheEvict(key);
+        }
+    }
 
+    tran = glp_mpl_alloc_wksp();
 
-/* -------------------------------------------------------------------------- */
-/* read MIP solution from text file */
-SEXP readMIP(SEXP lp, SEXP fname) {
+    if ( setjmp(jenv) ) {
+        glpkGuardHook();
+        glp_mpl_free_wksp(tran);
+        Rf_error("GLPK error while generating model '%s'!", rmodel);
+    }
 
-    SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
 
-    checkProb(lp);
+    check = glp_mpl_read_model(tran, rmodel, rskip);
+    for (k = 0; (k < ndata) && (check == 0); k++) {
+        check = glp_mpl_read_data(tran, CHAR(STRING_ELT(data, k)));
+    }
+    if (check == 0) {
+        check = glp_mpl_generate(tran, NULL);
+    }
+    if (check == 0) {
+        glp_mpl_build_prob(tran, prob);
+    }
 
-    check = glp_read_mip(R_ExternalPtrAddr(lp), rfname);
+    glpkGuardHook();
 
-    out = Rf_ScalarInteger(check);
+    glp_mpl_free_wksp(tran);
+
+    if (check != 0) {
+        Rf_error("Translation of model '%s' failed!", rmodel);
+    }
+
+    if (glpkCacheEnabled()) {
+        if (glpkSnapWrite(prob, &buf) == 0) {
+            glpkCacheInsert(key, buf.data, buf.len);
+        }
+        else {
+            glpkBufFree(&buf);
+        }
+    }
+
+    out = Rf_ScalarLogical(0);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* write MIP solution to text file */
-SEXP writeMIP(SEXP lp, SEXP fname) {
+/* read data section from R objects, streamed without an intermediate file */
+SEXP mplBindData(SEXP wk, SEXP sets, SEXP params, SEXP tmpname) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    const char *rtmpname;
+    glpkBuf buf = { NULL, 0, 0 };
+    glpkFeed feed;
     int check = 0;
 
-    checkProb(lp);
+    checkMathProg(wk);
 
-    check = glp_write_mip(R_ExternalPtrAddr(lp), rfname);
+    if (tmpname == R_NilValue) {
+        rtmpname = NULL;
+    }
+    else {
+        rtmpname = CHAR(STRING_ELT(tmpname, 0));
+    }
 
-    out = Rf_ScalarInteger(check);
+    if (glpkMplFormatData(sets, params, &buf) != 0) {
+        glpkBufFree(&buf);
+        Rf_error("Can not allocate memory for the data section!");
+    }
 
-    return out;
-}
+    if (glpkFeedOpen(&feed, &buf, rtmpname) != 0) {
+        glpkBufFree(&buf);
+        Rf_error("Can not pass the data section to GLPK!");
+    }
 
+    if ( setjmp(jenv) ) {
+        glpkGuardHook();
+        glpkFeedClose(&feed);
+        glpkBufFree(&buf);
+        return out;
+    }
 
-/* -------------------------------------------------------------------------- */
-/* determine library version */
-SEXP version() {
+    ge.e = 100;
+    glp_error_hook( (func) &cleanGLPKerror, &ge );
 
-    SEXP out = R_NilValue;
+    check = glp_mpl_read_data(R_ExternalPtrAddr(wk), feed.fname);
 
-    const char *vstr = glp_version();
+    glpkGuardHook();
 
-    out = Rf_mkString(vstr);
+    glpkFeedClose(&feed);
+    glpkBufFree(&buf);
+
+    if (check != 0) {
+        out = Rf_ScalarInteger(check);
+    }
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* check if the basis factorization exists */
-SEXP bfExists(SEXP lp) {
+/* build many instances of one model in parallel */
+SEXP mplBuildBatch(SEXP lps, SEXP model, SEXP data, SEXP skip,
+                   SEXP nworkers, SEXP outfiles) {
 
     SEXP out = R_NilValue;
-    int bex = 0;
+    SEXP files, lp;
+    glpkBatch bt;
+    const char **dfiles, **ofiles = NULL;
+    int *dbeg;
+    int ninst = Rf_length(data);
+    int nf = 0;
+    int k, d, mode;
 
-    checkProb(lp);
+    if (outfiles == R_NilValue) {
+        if (Rf_length(lps) != ninst) {
+            Rf_error("Need one problem object per instance!");
+        }
+        for (k = 0; k < ninst; k++) {
+            lp = VECTOR_ELT(lps, k);
+            checkProb(lp);
+        }
+    }
+    else {
+        if (Rf_length(outfiles) != ninst) {
+            Rf_error("Need one output file per instance!");
+        }
+        ofiles = (const char **) R_alloc(ninst, sizeof(const char *));
+        for (k = 0; k < ninst; k++) {
+            ofiles[k] = CHAR(STRING_ELT(outfiles, k));
+        }
+    }
 
-    bex = glp_bf_exists(R_ExternalPtrAddr(lp));
+    for (k = 0; k < ninst; k++) {
+        nf += Rf_length(VECTOR_ELT(data, k));
+    }
 
-    out = Rf_ScalarInteger(bex);
+    /* the worker threads must not touch R objects, collect the file names */
+    dfiles = (const char **) R_alloc(nf + 1, sizeof(const char *));
+    dbeg = (int *) R_alloc(ninst + 1, sizeof(int));
+    nf = 0;
+    for (k = 0; k < ninst; k++) {
+        files = VECTOR_ELT(data, k);
+        dbeg[k] = nf;
+        for (d = 0; d < Rf_length(files); d++) {
+            dfiles[nf++] = CHAR(STRING_ELT(files, d));
+        }
+    }
+    dbeg[ninst] = nf;
+
+    PROTECT(out = Rf_allocVector(INTSXP, ninst));
+
+    bt.model    = CHAR(STRING_ELT(model, 0));
+    bt.skip     = Rf_asInteger(skip);
+    bt.ninst    = ninst;
+    bt.dfiles   = dfiles;
+    bt.dbeg     = dbeg;
+    bt.outfiles = ofiles;
+    bt.snap     = (glpkBuf *) R_alloc(ninst, sizeof(glpkBuf));
+    bt.status   = INTEGER(out);
+    memset(bt.snap, 0, ninst * sizeof(glpkBuf));
+
+    mode = glpkBatchRun(&bt, Rf_asInteger(nworkers));
+
+    /* instances built in this thread removed the error hook */
+    glpkGuardHook();
+
+    for (k = 0; k < ninst; k++) {
+        if ( (outfiles == R_NilValue) && (bt.status[k] == GLPK_BATCH_OK) ) {
+            lp = VECTOR_ELT(lps, k);
+            if (glpkSnapRead(R_ExternalPtrAddr(lp),
+                             bt.snap[k].data, bt.snap[k].len) != 0) {
+                bt.status[k] = GLPK_BATCH_ESNAP;
+            }
+        }
+        glpkBufFree(&bt.snap[k]);
+    }
+
+    Rf_setAttrib(out, Rf_install("mode"),
+                 Rf_mkString( (mode == GLPK_BATCH_THREADS) ? "threads" :
+                              (mode == GLPK_BATCH_FORK) ? "fork" : "serial" ));
 
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* compute the basis factorization */
-SEXP factorize(SEXP lp) {
+/* read problem data from a binary snapshot */
+SEXP readSnap(SEXP lp, SEXP fname) {
 
     SEXP out = R_NilValue;
-    int fex = 0;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    glpkBuf buf = { NULL, 0, 0 };
+    int check = 0;
 
     checkProb(lp);
 
-    fex = glp_factorize(R_ExternalPtrAddr(lp));
+    check = glpkSnapLoad(&buf, rfname);
+    if (check == 0) {
+        check = glpkSnapRead(R_ExternalPtrAddr(lp), buf.data, buf.len);
+    }
+    glpkBufFree(&buf);
 
-    out = Rf_ScalarInteger(fex);
+    out = Rf_ScalarInteger(check);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* check if the basis factorization has been updated */
-SEXP bfUpdated(SEXP lp) {
+/* write problem data as binary snapshot */
+SEXP writeSnap(SEXP lp, SEXP fname) {
 
     SEXP out = R_NilValue;
-    int bup = 0;
+    const char *rfname = CHAR(STRING_ELT(fname, 0));
+    glpkBuf buf = { NULL, 0, 0 };
+    int check = 0;
 
     checkProb(lp);
 
-    bup = glp_bf_updated(R_ExternalPtrAddr(lp));
+    check = glpkSnapWrite(R_ExternalPtrAddr(lp), &buf);
+    if (check == 0) {
+        check = glpkSnapSave(&buf, rfname);
+    }
+    glpkBufFree(&buf);
 
-    out = Rf_ScalarInteger(bup);
+    out = Rf_ScalarInteger(check);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* change basis factorization control parameters */
-SEXP setBfcp(SEXP lp, SEXP npari, SEXP pari, SEXP vali,
-                      SEXP npard, SEXP pard, SEXP vald) {
-
-    SEXP out   = R_NilValue;
-
-    glp_bfcp parmB;
+/* generate a synthetic model into a problem object or a snapshot file */
+SEXP genModel(SEXP lp, SEXP dims, SEXP dparm, SEXP fname) {
 
-    int *rpari;
-    int *rvali;
-
-    int *rpard;
-    double *rvald;
-
-    int i, d;
-
-    checkProb(lp);
-
-    /* get current values of control parameters */
-    glp_get_bfcp(R_ExternalPtrAddr(lp), &parmB);
+    SEXP out = R_NilValue;
+    glpkGenParm gp;
+    double nnz, mem0;
+    int check = 0;
 
-    if (Rf_asInteger(npari) == 0) {
-        rpari = NULL;
-        rvali = NULL;
+    if (fname == R_NilValue) {
+        checkProb(lp);
     }
-    else {
-        rpari = INTEGER(pari);
-        rvali = INTEGER(vali);
 
-        for (i = 0; i < Rf_asInteger(npari); i++) {
-            /* Rprintf("par: %i  val: %i\n", rpari[i], rvali[i]); */
-            switch (rpari[i]) {
-                case 401:
-                    parmB.type = rvali[i];
-                    break;
-                case 402:
-                    parmB.lu_size = rvali[i];
-                    break;
-                case 403:
-                    parmB.piv_lim = rvali[i];
-                    break;
-                case 404:
-                    parmB.suhl = rvali[i];
-                    break;
-                case 405:
-                    parmB.nfs_max = rvali[i];
-                    break;
-                case 406:
-                    parmB.nrs_max = rvali[i];
-                    break;
-                case 407:
-                    parmB.rs_size = rvali[i];
-                    break;
-                default:
-                    Rf_warning("Unknown integer basis factorization parameter: %i!", rpari[i]);
-                    break;
-            }
-        }
+    if ( (Rf_length(dims) != 2) || (Rf_length(dparm) != 7) ) {
+        Rf_error("Invalid model parameters!");
+    }
 
+    gp.m       = INTEGER(dims)[0];
+    gp.n       = INTEGER(dims)[1];
+    gp.nnzcol  = REAL(dparm)[0];
+    gp.rev     = REAL(dparm)[1];
+    gp.cmin    = REAL(dparm)[2];
+    gp.cmax    = REAL(dparm)[3];
+    gp.intfrac = REAL(dparm)[4];
+    gp.bound   = REAL(dparm)[5];
+    gp.seed    = REAL(dparm)[6];
+
+    if ( (gp.m == NA_INTEGER) || (gp.m < 1) ||
+         (gp.n == NA_INTEGER) || (gp.n < 1) ) {
+        Rf_error("Numbers of rows and columns must be positive!");
+    }
+    if ( !(gp.nnzcol >= 1) || ((double) gp.m * gp.nnzcol > 2e9) ) {
+        Rf_error("Invalid number of nonzeros per column!");
+    }
+    if ( !(gp.rev >= 0) || !(gp.rev <= 1) ||
+         !(gp.intfrac >= 0) || !(gp.intfrac <= 1) ) {
+        Rf_error("Fractions must be in [0, 1]!");
+    }
+    if ( !(gp.cmin > 0) || !(gp.cmax >= gp.cmin) || !R_FINITE(gp.cmax) ) {
+        Rf_error("Invalid range of coefficients!");
+    }
+    if ( !(gp.bound > 0) || !R_FINITE(gp.bound) ||
+         !(gp.seed >= 0) || !(gp.seed < 18446744073709551616.0) ) {
+        Rf_error("Invalid bound or seed!");
     }
 
-    if (Rf_asInteger(npard) == 0) {
-        rpard = NULL;
-        rvald = NULL;
+    if (fname == R_NilValue) {
+        mem0 = glpkMemTotal();
+        check = glpkGenModel(&gp, R_ExternalPtrAddr(lp), NULL, &nnz);
+        memAccount(lp, mem0);
     }
     else {
-        rpard = INTEGER(pard);
-        rvald = REAL(vald);
-
-        for (d = 0; d < Rf_asInteger(npard); d++) {
-            /* Rprintf("par: %i  val: %i\n", rpard[d], rvald[d]); */
-            switch (rpard[d]) {
-                case 501:
-                    parmB.piv_tol = rvald[d];
-                    break;
-                case 502:
-                    parmB.eps_tol = rvald[d];
-                    break;
-                case 503:
-                    parmB.max_gro = rvald[d];
-                    break;
-                case 504:
-                    parmB.upd_tol = rvald[d];
-                    break;
-                default:
-                    Rf_warning("Unknown double basis factorization parameter: %i!", rpard[d]);
-                    break;
-            }
-        }
-
+        check = glpkGenModel(&gp, NULL, CHAR(STRING_ELT(fname, 0)), &nnz);
     }
 
-    /* set new values of control parameters */
-    glp_set_bfcp(R_ExternalPtrAddr(lp), &parmB);
+    PROTECT(out = Rf_ScalarInteger(check));
+    Rf_setAttrib(out, Rf_install("nnz"), Rf_ScalarReal(nnz));
+    UNPROTECT(1);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* get basis factorization control parameters */
-SEXP getBfcp(SEXP lp) {
+/* minimum and maximum of an index vector */
 
-    glp_bfcp parmB;
-
-    SEXP listv   = R_NilValue;
-    SEXP parmext = R_NilValue;
-    SEXP intids  = R_NilValue;
-    SEXP dbids   = R_NilValue;
+static void indexRange(const int *x, R_xlen_t n, int *lo, int *hi) {
 
-    SEXP pint  = R_NilValue;
-    SEXP pdb   = R_NilValue;
+    R_xlen_t k;
+    int mn = INT_MAX;
+    int mx = INT_MIN;
 
-    /* get current values of control parameters */
-    glp_get_bfcp(R_ExternalPtrAddr(lp), &parmB);
+    /* no branches and no early exit, so that the compiler vectorizes the
+       loop; NA_integer_ is INT_MIN and ends up below 1 */
+    for (k = 0; k < n; k++) {
+        mn = (x[k] < mn) ? x[k] : mn;
+        mx = (x[k] > mx) ? x[k] : mx;
+    }
 
-    PROTECT(pint = Rf_allocVector(INTSXP, 7));
-    PROTECT(pdb  = Rf_allocVector(REALSXP, 4));
+    *lo = mn;
+    *hi = mx;
+}
 
-    INTEGER(pint)[0] = parmB.type;
-    INTEGER(pint)[1] = parmB.lu_size;
-    INTEGER(pint)[2] = parmB.piv_lim;
-    INTEGER(pint)[3] = parmB.suhl;
-    INTEGER(pint)[4] = parmB.nfs_max;
-    INTEGER(pint)[5] = parmB.nrs_max;
-    INTEGER(pint)[6] = parmB.rs_size;
+void glpkCheckIndices(SEXP x, int first, int nmax, const char *what,
+                      const char *arg) {
 
-    REAL(pdb)[0] = parmB.piv_tol;
-    REAL(pdb)[1] = parmB.eps_tol;
-    REAL(pdb)[2] = parmB.max_gro;
-    REAL(pdb)[3] = parmB.upd_tol;
+    R_xlen_t k, n;
+    const int *rx;
+    int lo, hi;
 
-    PROTECT(intids = Rf_allocVector(STRSXP, 7));
-    SET_STRING_ELT(intids, 0, Rf_mkChar("type"));
-    SET_STRING_ELT(intids, 1, Rf_mkChar("lu_size"));
-    SET_STRING_ELT(intids, 2, Rf_mkChar("piv_lim"));
-    SET_STRING_ELT(intids, 3, Rf_mkChar("suhl"));
-    SET_STRING_ELT(intids, 4, Rf_mkChar("nfs_max"));
-    SET_STRING_ELT(intids, 5, Rf_mkChar("nrs_max"));
-    SET_STRING_ELT(intids, 6, Rf_mkChar("rs_size"));
+    if (x == R_NilValue) {
+        return;
+    }
 
-    PROTECT(dbids = Rf_allocVector(STRSXP, 4));
-    SET_STRING_ELT(dbids, 0, Rf_mkChar("piv_tol"));
-    SET_STRING_ELT(dbids, 1, Rf_mkChar("eps_tol"));
-    SET_STRING_ELT(dbids, 2, Rf_mkChar("max_gro"));
-    SET_STRING_ELT(dbids, 3, Rf_mkChar("upd_tol"));
+    n = Rf_xlength(x);
+    if (n <= first) {
+        return;
+    }
+    rx = INTEGER(x);
 
-    Rf_setAttrib(pint, R_NamesSymbol, intids);
-    Rf_setAttrib(pdb, R_NamesSymbol, dbids);
+    indexRange(rx + first, n - first, &lo, &hi);
+    if ( (lo >= 1) && (hi <= nmax) ) {
+        return;
+    }
 
-    PROTECT(parmext = Rf_allocVector(VECSXP, 2));
-    SET_VECTOR_ELT(parmext, 0, pint);
-    SET_VECTOR_ELT(parmext, 1, pdb);
+    for (k = first; k < n; k++) {
+        if ( (rx[k] > nmax) || (rx[k] < 1) ) {
+            Rf_error("%s index '%s[%i] = %i' is out of range!", what, arg,
+                     (int) (first ? k : (k+1)), rx[k]);
+        }
+    }
+}
 
-    PROTECT(listv = Rf_allocVector(STRSXP, 2));
-    SET_STRING_ELT(listv, 0, Rf_mkChar("integer"));
-    SET_STRING_ELT(listv, 1, Rf_mkChar("double"));
 
-    Rf_setAttrib(parmext, R_NamesSymbol, listv);
+/* -------------------------------------------------------------------------- */
+/* are arguments to GLPK checked */
+SEXP getCheckArgs(void) {
 
-    UNPROTECT(6);
+    SEXP out = R_NilValue;
 
-    return parmext;
+#ifdef CHECK_GLPK_ARGS
+    out = Rf_ScalarLogical(glpkCheckArgs);
+#else
+    out = Rf_ScalarLogical(0);
+#endif
 
+    return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve basis header information */
-SEXP getBhead(SEXP lp, SEXP k) {
+/* switch checking of arguments to GLPK on or off */
+SEXP setCheckArgs(SEXP on) {
 
     SEXP out = R_NilValue;
-    int bh;
 
-    checkProb(lp);
-
-    bh = glp_get_bhead(R_ExternalPtrAddr(lp), Rf_asInteger(k));
+    out = Rf_ScalarLogical(glpkCheckArgs);
 
-    out = Rf_ScalarInteger(bh);
+    glpkCheckArgs = (Rf_asLogical(on) == TRUE) ? 1 : 0;
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve row index in the basis header */
-SEXP getRbind(SEXP lp, SEXP i) {
+/* switch profiling of the entry points on or off */
+SEXP setProfiling(SEXP on) {
 
     SEXP out = R_NilValue;
-    int rh;
-
-    checkProb(lp);
-    checkRowIndex(lp, i);
 
-    rh = glp_get_row_bind(R_ExternalPtrAddr(lp), Rf_asInteger(i));
+    out = Rf_ScalarLogical(glpkProfEnabled);
 
-    out = Rf_ScalarInteger(rh);
+    glpkProfSet(Rf_asLogical(on) == TRUE);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* retrieve column index in the basis header */
-SEXP getCbind(SEXP lp, SEXP j) {
+/* get profiling counters of the entry points */
+SEXP getProfiling(void) {
 
-    SEXP out = R_NilValue;
-    int ch;
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
+    SEXP name, ncalls, ttime, tmax, elem;
+
+    const char **names;
+    const double *calls, *time, *max, *nelem;
+    int k, n;
+
+    n = glpkProfInfo(&names, &calls, &time, &max, &nelem);
+
+    PROTECT(name   = Rf_allocVector(STRSXP, n));
+    PROTECT(ncalls = Rf_allocVector(REALSXP, n));
+    PROTECT(ttime  = Rf_allocVector(REALSXP, n));
+    PROTECT(tmax   = Rf_allocVector(REALSXP, n));
+    PROTECT(elem   = Rf_allocVector(REALSXP, n));
+
+    for (k = 0; k < n; k++) {
+        SET_STRING_ELT(name, k, Rf_mkChar(names[k]));
+        REAL(ncalls)[k] = calls[k];
+        REAL(ttime)[k]  = time[k];
+        REAL(tmax)[k]   = max[k];
+        REAL(elem)[k]   = nelem[k];
+    }
 
-    checkProb(lp);
-    checkColIndex(lp, j);
+    PROTECT(out = Rf_allocVector(VECSXP, 6));
+    SET_VECTOR_ELT(out, 0, name);
+    SET_VECTOR_ELT(out, 1, ncalls);
+    SET_VECTOR_ELT(out, 2, ttime);
+    SET_VECTOR_ELT(out, 3, tmax);
+    SET_VECTOR_ELT(out, 4, elem);
+    SET_VECTOR_ELT(out, 5, Rf_ScalarLogical(glpkProfEnabled));
 
-    ch = glp_get_col_bind(R_ExternalPtrAddr(lp), Rf_asInteger(j));
+    PROTECT(listv = Rf_allocVector(STRSXP, 6));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("routine"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("calls"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("time"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("max_time"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("elements"));
+    SET_STRING_ELT(listv, 5, Rf_mkChar("enabled"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    out = Rf_ScalarInteger(ch);
+    UNPROTECT(7);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* print sensitivity analysis report */
-SEXP printRanges(SEXP lp, SEXP numrc, SEXP rowcol, SEXP fname) {
+/* clear profiling counters */
+SEXP resetProfiling(void) {
 
     SEXP out = R_NilValue;
 
-    const int *rrowcol;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int sensit;
+    glpkProfReset();
 
-    if (rowcol == R_NilValue) {
-        rrowcol = NULL;
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* get solve statistics */
+SEXP getSolveStats(void) {
+
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
+    SEXP stats, ret;
+
+    const glpkStat *st;
+    glpkStat all;
+    const glpkStat *row[GLPK_SOLVER_NUM + 1];
+    double *ps, *pr;
+    int nr = GLPK_SOLVER_NUM + 1;
+    int k, c;
+
+    /* the last row summarizes all solvers */
+    memset(&all, 0, sizeof(glpkStat));
+    for (k = 0; k < GLPK_SOLVER_NUM; k++) {
+        st = glpkStatGet(k);
+        glpkHistMerge(&all.time, &st->time);
+        glpkHistMerge(&all.iter, &st->iter);
+        for (c = 0; c < GLPK_STAT_NRET; c++) {
+            all.ret[c] += st->ret[c];
+        }
+        row[k] = st;
     }
-    else {
-        rrowcol = INTEGER(rowcol);
+    row[GLPK_SOLVER_NUM] = &all;
+
+    /* per row: solves, total/mean/p50/p95/p99/max time,
+       total/mean/p50/p95/p99/max iterations */
+    PROTECT(stats = Rf_allocMatrix(REALSXP, nr, 13));
+    PROTECT(ret = Rf_allocMatrix(REALSXP, nr, GLPK_STAT_NRET));
+    ps = REAL(stats);
+    pr = REAL(ret);
+
+    for (k = 0; k < nr; k++) {
+        st = row[k];
+        ps[k]        = st->time.n;
+        ps[k + nr]   = st->time.sum;
+        ps[k + 2*nr] = (st->time.n > 0) ? st->time.sum / st->time.n : R_NaN;
+        ps[k + 3*nr] = glpkHistQuantile(&st->time, GLPK_HIST_TIME_LO, 0.50);
+        ps[k + 4*nr] = glpkHistQuantile(&st->time, GLPK_HIST_TIME_LO, 0.95);
+        ps[k + 5*nr] = glpkHistQuantile(&st->time, GLPK_HIST_TIME_LO, 0.99);
+        ps[k + 6*nr] = (st->time.n > 0) ? st->time.max : R_NaN;
+        ps[k + 7*nr] = (st->iter.n > 0) ? st->iter.sum : R_NaN;
+        ps[k + 8*nr] = (st->iter.n > 0) ? st->iter.sum / st->iter.n : R_NaN;
+        ps[k + 9*nr] = glpkHistQuantile(&st->iter, GLPK_HIST_ITER_LO, 0.50);
+        ps[k + 10*nr] = glpkHistQuantile(&st->iter, GLPK_HIST_ITER_LO, 0.95);
+        ps[k + 11*nr] = glpkHistQuantile(&st->iter, GLPK_HIST_ITER_LO, 0.99);
+        ps[k + 12*nr] = (st->iter.n > 0) ? st->iter.max : R_NaN;
+        for (c = 0; c < GLPK_STAT_NRET; c++) {
+            pr[k + c*nr] = st->ret[c];
+        }
     }
 
-    checkProb(lp);
+    PROTECT(out = Rf_allocVector(VECSXP, 2));
+    SET_VECTOR_ELT(out, 0, stats);
+    SET_VECTOR_ELT(out, 1, ret);
 
-    sensit = glp_print_ranges(R_ExternalPtrAddr(lp), Rf_asInteger(numrc),
-                              rrowcol, 0, rfname
-                             );
+    PROTECT(listv = Rf_allocVector(STRSXP, 2));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("stats"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("status"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    out = Rf_ScalarInteger(sensit);
+    UNPROTECT(4);
 
     return out;
-
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* allocate translator workspace */
-SEXP mplAllocWksp(SEXP ptrtype) {
+/* clear solve statistics */
+SEXP resetSolveStats(void) {
 
-    SEXP wkext = R_NilValue;
-    SEXP ptr, class;
-    
-    glp_tran *wk;
+    SEXP out = R_NilValue;
 
-    /* create translator workspace pointer */
-    PROTECT(ptr = Rf_allocVector(STRSXP, 1));
-    SET_STRING_ELT(ptr, 0, STRING_ELT(ptrtype, 0));
+    glpkStatReset();
 
-    PROTECT(class = Rf_allocVector(STRSXP, 1));
-    SET_STRING_ELT(class, 0, Rf_mkChar("trwks_ptr"));
+    return out;
+}
 
-    wk = glp_mpl_alloc_wksp();
 
-    wkext = R_MakeExternalPtr(wk, tagMATHprog, R_NilValue);
-    PROTECT(wkext);
-    R_RegisterCFinalizerEx(wkext, mathProgFinalizer, TRUE);
-    Rf_setAttrib(ptr, class, wkext);
-    Rf_classgets(ptr, class);
-    UNPROTECT(3);
+/* -------------------------------------------------------------------------- */
+/* enable or disable interrupt polling during solves */
+SEXP setInterrupt(SEXP on) {
 
-    return ptr;
+    SEXP out = R_NilValue;
+
+    out = Rf_ScalarLogical(glpkSolveInterrupt);
+
+    glpkSolveInterrupt = (Rf_asLogical(on) == TRUE);
+
+    return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* free translator workspace */
-SEXP mplFreeWksp(SEXP wksp) {
+/* get memory usage of GLPK */
+SEXP getMemUsage(void) {
 
-    SEXP out = R_NilValue;
-    glp_tran *delwk = NULL;
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
 
-    checkMathProg(wksp);
+    double count, cpeak, total, tpeak;
 
-    delwk = R_ExternalPtrAddr(wksp);
+    glpkMemUsage(&count, &cpeak, &total, &tpeak);
 
-    glp_mpl_free_wksp(delwk);
-    R_ClearExternalPtr(wksp);
+    PROTECT(out = Rf_allocVector(REALSXP, 6));
+    REAL(out)[0] = count;
+    REAL(out)[1] = cpeak;
+    REAL(out)[2] = total;
+    REAL(out)[3] = tpeak;
+    REAL(out)[4] = (glpkMemLimit > 0) ? (double) glpkMemLimit : NA_REAL;
+    REAL(out)[5] = glpkGcHeld();
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 6));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("count"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("cpeak"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("total"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("tpeak"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("limit"));
+    SET_STRING_ELT(listv, 5, Rf_mkChar("held"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    UNPROTECT(2);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read and translate model section */
-SEXP mplReadModel(SEXP wk, SEXP fname, SEXP skip) {
+/* set or remove the memory limit of GLPK */
+SEXP setMemLimit(SEXP limit) {
 
     SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
 
-    checkMathProg(wk);
+    out = Rf_ScalarInteger( (glpkMemLimit > 0) ? glpkMemLimit : NA_INTEGER );
 
-    if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
-        return out;
+    if (limit == R_NilValue) {
+        glpkMemSetLimit(0);
+    }
+    else {
+        if ( (Rf_asInteger(limit) == NA_INTEGER) ||
+             (Rf_asInteger(limit) < 1) ) {
+            Rf_error("Memory limit must be a positive number of megabytes!");
+        }
+        glpkMemSetLimit(Rf_asInteger(limit));
     }
 
-    ge.e = 100;
-    glp_error_hook( (func) &cleanGLPKerror, &ge );
+    return out;
+}
 
-    check = glp_mpl_read_model(R_ExternalPtrAddr(wk),
-                               rfname, Rf_asInteger(skip));
 
-    glp_error_hook( NULL, NULL );
-    
-    if (check != 0) {
-        out = Rf_ScalarInteger(check);
+/* -------------------------------------------------------------------------- */
+/* set the growth of GLPK memory triggering a garbage collection */
+SEXP setGcTrigger(SEXP mb) {
+
+    SEXP out = R_NilValue;
+
+    out = Rf_ScalarReal(glpkGcTrigger / 1048576.0);
+
+    if ( (ISNAN(Rf_asReal(mb))) || (Rf_asReal(mb) < 0) ) {
+        Rf_error("Trigger must be a non-negative number of megabytes!");
     }
+    glpkGcTrigger = Rf_asReal(mb) * 1048576.0;
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* read and translate data section */
-SEXP mplReadData(SEXP wk, SEXP fname) {
+/* get memory used during the last solve of a problem */
+SEXP getSolveMem(SEXP lp) {
 
-    SEXP out = R_NilValue;
-    const char *rfname = CHAR(STRING_ELT(fname, 0));
-    int check = 0;
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
 
-    checkMathProg(wk);
+    glpkProbInfo *pi;
 
-    if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
+    checkProb(lp);
+
+    pi = probInfo(lp, 0);
+    if ( (pi == NULL) || (pi->mem.solver < 0) ) {
         return out;
     }
 
-    ge.e = 100;
-    glp_error_hook( (func) &cleanGLPKerror, &ge );
-
-    check = glp_mpl_read_data(R_ExternalPtrAddr(wk), rfname);
+    PROTECT(out = Rf_allocVector(VECSXP, 5));
+    SET_VECTOR_ELT(out, 0, Rf_ScalarInteger(pi->mem.solver));
+    SET_VECTOR_ELT(out, 1, Rf_ScalarReal(pi->mem.before));
+    SET_VECTOR_ELT(out, 2, Rf_ScalarReal(pi->mem.peak));
+    SET_VECTOR_ELT(out, 3, Rf_ScalarReal(pi->mem.after));
+    SET_VECTOR_ELT(out, 4, Rf_ScalarLogical(pi->mem.exact));
 
-    glp_error_hook( NULL, NULL );
+    PROTECT(listv = Rf_allocVector(STRSXP, 5));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("solver"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("before"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("peak"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("after"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("exact"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    if (check != 0) {
-        out = Rf_ScalarInteger(check);
-    }
+    UNPROTECT(2);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* generate the model */
-SEXP mplGenerate(SEXP wk, SEXP fname) {
+/* set or remove the time budget of the session */
+SEXP setTimeBudget(SEXP secs, SEXP nsolves) {
 
     SEXP out = R_NilValue;
-    const char *rfname;
-    int check = 0;
 
-    checkMathProg(wk);
-
-    if (fname == R_NilValue) {
-        rfname = NULL;
+    if (secs == R_NilValue) {
+        glpkBudgetSet(R_NaN, R_NaN);
     }
     else {
-        rfname = CHAR(STRING_ELT(fname, 0));
+        glpkBudgetSet(Rf_asReal(secs), Rf_asReal(nsolves));
     }
 
-    if ( setjmp(jenv) ) {
-        glp_error_hook( NULL, NULL );
-        return out;
-    }
+    return out;
+}
 
-    ge.e = 100;
-    glp_error_hook( (func) &cleanGLPKerror, &ge );
 
-    check = glp_mpl_generate(R_ExternalPtrAddr(wk), rfname);
+/* -------------------------------------------------------------------------- */
+/* get the state of the time budget */
+SEXP getTimeBudget(void) {
+
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
+    double rem, left, skipped, stopped;
+    int on;
 
-    glp_error_hook( NULL, NULL );
+    on = glpkBudgetGet(&rem, &left, &skipped, &stopped);
 
-    if (check != 0) {
-        out = Rf_ScalarInteger(check);
-    }
+    PROTECT(out = Rf_allocVector(VECSXP, 5));
+    SET_VECTOR_ELT(out, 0, Rf_ScalarLogical(on));
+    SET_VECTOR_ELT(out, 1, Rf_ScalarReal( (on) ? rem : NA_REAL ));
+    SET_VECTOR_ELT(out, 2, Rf_ScalarReal( ( (on) && (left > 0) ) ?
+                                          left : NA_REAL ));
+    SET_VECTOR_ELT(out, 3, Rf_ScalarReal(skipped));
+    SET_VECTOR_ELT(out, 4, Rf_ScalarReal(stopped));
+
+    PROTECT(listv = Rf_allocVector(STRSXP, 5));
+    SET_STRING_ELT(listv, 0, Rf_mkChar("active"));
+    SET_STRING_ELT(listv, 1, Rf_mkChar("remaining"));
+    SET_STRING_ELT(listv, 2, Rf_mkChar("solves"));
+    SET_STRING_ELT(listv, 3, Rf_mkChar("skipped"));
+    SET_STRING_ELT(listv, 4, Rf_mkChar("stopped"));
+    Rf_setAttrib(out, R_NamesSymbol, listv);
+
+    UNPROTECT(2);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* build problem instance from model */
-SEXP mplBuildProb(SEXP wk, SEXP lp) {
+/* capture the solver log of a problem */
+SEXP setLogCapture(SEXP lp, SEXP on, SEXP size, SEXP pass, SEXP interval) {
 
     SEXP out = R_NilValue;
+    glpkProbInfo *pi;
+    glpkLog *log;
 
-    checkMathProg(wk);
     checkProb(lp);
 
-    glp_mpl_build_prob(R_ExternalPtrAddr(wk), R_ExternalPtrAddr(lp));
+    pi = probInfo(lp, 1);
+
+    if (Rf_asLogical(on) != TRUE) {
+        glpkLogFree(pi->log);
+        pi->log = NULL;
+        return out;
+    }
+
+    if ( (pi->log == NULL) || (pi->log->cap != Rf_asInteger(size)) ) {
+        log = glpkLogAlloc(Rf_asInteger(size));
+        if (log == NULL) {
+            Rf_error("Can not allocate memory for the solver log!");
+        }
+        glpkLogFree(pi->log);
+        pi->log = log;
+    }
+
+    pi->log->pass     = (Rf_asLogical(pass) == TRUE);
+    pi->log->interval = Rf_asReal(interval);
 
     return out;
 }
 
 
 /* -------------------------------------------------------------------------- */
-/* postsolve model */
-SEXP mplPostsolve(SEXP wk, SEXP lp, SEXP sol) {
+/* get the captured solver log of a problem */
+SEXP getLog(SEXP lp) {
 
-    SEXP out = R_NilValue;
-    int check = 0;
+    SEXP listv = R_NilValue;
+    SEXP out   = R_NilValue;
+    SEXP col[11];
+
+    const char *cname[] = { "solve", "solver", "time", "iter", "obj",
+                            "infeas", "bound", "gap", "active", "done",
+                            "phase2" };
+    const char *kname[] = { "simplex", "interior", "mip" };
+    glpkProbInfo *pi;
+    const glpkLogEntry *ent;
+    int k, n = 0;
 
-    checkMathProg(wk);
     checkProb(lp);
-    checkSolType(sol);
 
-    ge.e = 100;
-    glp_error_hook( (func) &cleanGLPKerror, &ge );
+    pi = probInfo(lp, 0);
+    if ( (pi == NULL) || (pi->log == NULL) ) {
+        return out;
+    }
+    n = pi->log->n;
+
+    PROTECT(col[0]  = Rf_allocVector(INTSXP, n));
+    PROTECT(col[1]  = Rf_allocVector(STRSXP, n));
+    PROTECT(col[2]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[3]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[4]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[5]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[6]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[7]  = Rf_allocVector(REALSXP, n));
+    PROTECT(col[8]  = Rf_allocVector(INTSXP, n));
+    PROTECT(col[9]  = Rf_allocVector(INTSXP, n));
+    PROTECT(col[10] = Rf_allocVector(LGLSXP, n));
+
+    for (k = 0; k < n; k++) {
+        ent = glpkLogEntryAt(pi->log, k);
+        INTEGER(col[0])[k] = ent->solve;
+        SET_STRING_ELT(col[1], k, Rf_mkChar(kname[ent->kind]));
+        REAL(col[2])[k]    = ent->time;
+        REAL(col[3])[k]    = ent->iter;
+        REAL(col[4])[k]    = ent->obj;
+        REAL(col[5])[k]    = ent->infeas;
+        REAL(col[6])[k]    = ent->bound;
+        REAL(col[7])[k]    = ent->gap;
+        INTEGER(col[8])[k] = ent->active;
+        INTEGER(col[9])[k] = ent->done;
+        LOGICAL(col[10])[k] = ent->phase2;
+    }
 
-    check = glp_mpl_postsolve(R_ExternalPtrAddr(wk),
-                              R_ExternalPtrAddr(lp),
-                              Rf_asInteger(sol));
+    PROTECT(out = Rf_allocVector(VECSXP, 11));
+    PROTECT(listv = Rf_allocVector(STRSXP, 11));
+    for (k = 0; k < 11; k++) {
+        SET_VECTOR_ELT(out, k, col[k]);
+        SET_STRING_ELT(listv, k, Rf_mkChar(cname[k]));
+    }
+    Rf_setAttrib(out, R_NamesSymbol, listv);
 
-    glp_error_hook( NULL, NULL );
+    Rf_setAttrib(out, Rf_install("dropped"),
+                 Rf_ScalarReal(pi->log->dropped));
+    Rf_setAttrib(out, Rf_install("lines"), Rf_ScalarReal(pi->log->lines));
 
-    if (check != 0) {
-        out = Rf_ScalarInteger(check);
+    UNPROTECT(13);
+
+    return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* remove all entries from the captured solver log of a problem */
+SEXP clearLog(SEXP lp) {
+
+    SEXP out = R_NilValue;
+    glpkProbInfo *pi;
+
+    checkProb(lp);
+
+    pi = probInfo(lp, 0);
+    if ( (pi != NULL) && (pi->log != NULL) ) {
+        glpkLogClear(pi->log);
     }
 
     return out;
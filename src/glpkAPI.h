@@ -290,6 +290,9 @@ SEXP solveSimplex(SEXP lp);
 /* solve problem with exact simplex algorithm */
 SEXP solveSimplexExact(SEXP lp);
 
+/* solve problem with simplex algorithm and verify in exact arithmetic */
+SEXP solveSimplexHybrid(SEXP lp);
+
 /* get value of the objective function after simplex */
 SEXP getObjVal(SEXP lp);
 
@@ -344,6 +347,40 @@ SEXP getUnbndRay(SEXP lp);
 /* solve problem with interior point method */
 SEXP solveInterior(SEXP lp);
 
+/* crossover from the interior point solution to an optimal basis */
+SEXP crossover(SEXP lp, SEXP solve);
+
+/* solve with several methods at the same time, the first one wins */
+SEXP solveConcurrent(SEXP lp, SEXP methods);
+
+/* solve for a series of objectives, each starting from the previous basis */
+SEXP sweepObj(SEXP lp, SEXP p, SEXP ind, SEXP val, SEXP prim);
+
+/* solve for a grid of fixed values of two columns */
+SEXP sweepGrid(SEXP lp, SEXP j1, SEXP j2, SEXP g1, SEXP g2, SEXP nthreads);
+
+/* minimize a weighted L1 norm of columns */
+SEXP solveNormL1(SEXP lp, SEXP ind, SEXP ref, SEXP w, SEXP frac);
+
+/* append loopless constraints for internal reactions */
+SEXP addLoopless(SEXP lp, SEXP ind, SEXP bigM, SEXP eps);
+
+/* artificial centering hit-and-run sampling */
+SEXP sampleACHR(SEXP lp, SEXP warm, SEXP npoints, SEXP thin, SEXP chains,
+                SEXP seed, SEXP fname);
+
+/* find (and delete) columns which are zero in every feasible point */
+SEXP findBlocked(SEXP lp, SEXP tol, SEXP nrandom, SEXP seed, SEXP del);
+
+/* reduce problem lp into problem rlp, keep the reductions for postsolve */
+SEXP reduceProb(SEXP lp, SEXP rlp, SEXP tol);
+
+/* map the basic solution of a reduced problem back to the original problem */
+SEXP postsolve(SEXP lp, SEXP rlp, SEXP map);
+
+/* find (and delete) linearly dependent equality rows */
+SEXP findDepRows(SEXP lp, SEXP tol, SEXP del);
+
 /* get value of the objective function after interior point method */
 SEXP getObjValIpt(SEXP lp);
 
@@ -508,3 +545,82 @@ SEXP mplBuildProb(SEXP wk, SEXP lp);
 /* postsolve model */
 SEXP mplPostsolve(SEXP wk, SEXP lp, SEXP sol);
 
+
+/* configure cache of generated MathProg problems */
+SEXP mplSetCache(SEXP enable, SEXP dir, SEXP maxent);
+
+/* get state of the cache of generated MathProg problems */
+SEXP mplGetCache(void);
+
+/* remove all problems from the cache of generated MathProg problems */
+SEXP mplClearCache(SEXP disk);
+
+/* build problem instance from model and data files, using the cache */
+SEXP mplCachedProb(SEXP lp, SEXP model, SEXP data, SEXP skip, SEXP salt);
+
+/* read data section from R objects */
+SEXP mplBindData(SEXP wk, SEXP sets, SEXP params, SEXP tmpname);
+
+/* build many instances of one model in parallel */
+SEXP mplBuildBatch(SEXP lps, SEXP model, SEXP data, SEXP skip,
+                   SEXP nworkers, SEXP outfiles);
+
+/* read problem data from a binary snapshot */
+SEXP readSnap(SEXP lp, SEXP fname);
+
+/* write problem data as binary snapshot */
+SEXP writeSnap(SEXP lp, SEXP fname);
+
+/* generate a synthetic model into a problem object or a snapshot file */
+SEXP genModel(SEXP lp, SEXP dims, SEXP dparm, SEXP fname);
+
+/* are arguments to GLPK checked */
+SEXP getCheckArgs(void);
+
+/* switch checking of arguments to GLPK on or off */
+SEXP setCheckArgs(SEXP on);
+
+/* switch profiling of the entry points on or off */
+SEXP setProfiling(SEXP on);
+
+/* get profiling counters of the entry points */
+SEXP getProfiling(void);
+
+/* clear profiling counters */
+SEXP resetProfiling(void);
+
+/* get solve statistics */
+SEXP getSolveStats(void);
+
+/* clear solve statistics */
+SEXP resetSolveStats(void);
+
+/* enable or disable interrupt polling during solves */
+SEXP setInterrupt(SEXP on);
+
+/* get memory usage of GLPK */
+SEXP getMemUsage(void);
+
+/* set or remove the memory limit of GLPK */
+SEXP setMemLimit(SEXP limit);
+
+/* set the growth of GLPK memory triggering a garbage collection */
+SEXP setGcTrigger(SEXP mb);
+
+/* get memory used during the last solve of a problem */
+SEXP getSolveMem(SEXP lp);
+
+/* set or remove the time budget of the session */
+SEXP setTimeBudget(SEXP secs, SEXP nsolves);
+
+/* get the state of the time budget */
+SEXP getTimeBudget(void);
+
+/* capture the solver log of a problem */
+SEXP setLogCapture(SEXP lp, SEXP on, SEXP size, SEXP pass, SEXP interval);
+
+/* get the captured solver log of a problem */
+SEXP getLog(SEXP lp);
+
+/* remove all entries from the captured solver log of a problem */
+SEXP clearLog(SEXP lp);
@@ -0,0 +1,461 @@
+/* glpkBatch.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "glpkR.h"
+#include "glpkMem.h"
+#include "glpkSnapshot.h"
+#include "glpkBatch.h"
+
+#if defined(HAVE_PTHREAD) && !defined(_WIN32)
+#include <pthread.h>
+#define BATCH_THREADS
+#endif
+
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#define BATCH_FORK
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/* one instance                                                               */
+/* -------------------------------------------------------------------------- */
+
+struct batchErr {
+    jmp_buf env;
+};
+
+static void batchErrorHook(void *info) {
+    longjmp(((struct batchErr *) info)->env, 1);
+}
+
+/* Translate instance k into buf (or into its output file). If ownenv is
+   nonzero, the calling thread or process owns its GLPK environment and
+   releases it after a GLPK runtime error; the main thread of R must keep the
+   environment, because it holds the problem objects of the user, and gets
+   the error hook of its guard (see glpkMem.h) back. */
+static int batchBuild(const glpkBatch *bt, int k, glpkBuf *buf, int ownenv) {
+
+    glp_tran * volatile tran = NULL;
+    glp_prob * volatile prob = NULL;
+    struct batchErr err;
+    int status = GLPK_BATCH_OK;
+    int d;
+
+    buf->len = 0;
+
+    if (setjmp(err.env)) {
+        if (ownenv) {
+            /* releases tran and prob as well */
+            glp_error_hook(NULL, NULL);
+            glp_free_env();
+        }
+        else {
+            glpkGuardHook();
+            if (prob != NULL) {
+                glp_delete_prob(prob);
+            }
+            if (tran != NULL) {
+                glp_mpl_free_wksp(tran);
+            }
+        }
+        return GLPK_BATCH_EGLPK;
+    }
+
+    glp_error_hook(batchErrorHook, &err);
+
+    if (ownenv) {
+        glp_term_out(GLP_OFF);
+    }
+
+    tran = glp_mpl_alloc_wksp();
+
+    if (glp_mpl_read_model(tran, bt->model, bt->skip) != 0) {
+        status = GLPK_BATCH_EMODEL;
+    }
+    for (d = bt->dbeg[k]; (d < bt->dbeg[k+1]) && (status == GLPK_BATCH_OK); d++) {
+        if (glp_mpl_read_data(tran, bt->dfiles[d]) != 0) {
+            status = GLPK_BATCH_EDATA;
+        }
+    }
+    if ( (status == GLPK_BATCH_OK) && (glp_mpl_generate(tran, NULL) != 0) ) {
+        status = GLPK_BATCH_EGEN;
+    }
+    if (status == GLPK_BATCH_OK) {
+        prob = glp_create_prob();
+        glp_mpl_build_prob(tran, prob);
+        if (glpkSnapWrite(prob, buf) != 0) {
+            status = GLPK_BATCH_ESNAP;
+        }
+        glp_delete_prob(prob);
+        prob = NULL;
+    }
+
+    glp_mpl_free_wksp(tran);
+    tran = NULL;
+
+    /* the main thread of R runs under the guard of its entry point */
+    if (ownenv) {
+        glp_error_hook(NULL, NULL);
+    }
+    else {
+        glpkGuardHook();
+    }
+
+    if ( (status == GLPK_BATCH_OK) && (bt->outfiles != NULL) ) {
+        if (glpkSnapSave(buf, bt->outfiles[k]) != 0) {
+            status = GLPK_BATCH_ESNAP;
+        }
+        glpkBufFree(buf);
+    }
+
+    return status;
+}
+
+static void batchSerial(glpkBatch *bt, int first, int step) {
+
+    int k;
+
+    for (k = first; k < bt->ninst; k += step) {
+        bt->status[k] = batchBuild(bt, k, &bt->snap[k], 0);
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* threads                                                                    */
+/* -------------------------------------------------------------------------- */
+
+int glpkBatchThreadSafe(void) {
+#if defined(BATCH_THREADS) && defined(HAVE_GLP_CONFIG)
+    return (glp_config("TLS") != NULL);
+#else
+    return 0;
+#endif
+}
+
+#ifdef BATCH_THREADS
+
+struct batchCtx {
+    glpkBatch *bt;
+    int next;
+    pthread_mutex_t lock;
+};
+
+static void *batchThread(void *arg) {
+
+    struct batchCtx *ctx = arg;
+    int k;
+
+    for (;;) {
+        pthread_mutex_lock(&ctx->lock);
+        k = ctx->next++;
+        pthread_mutex_unlock(&ctx->lock);
+        if (k >= ctx->bt->ninst) {
+            break;
+        }
+        ctx->bt->status[k] = batchBuild(ctx->bt, k, &ctx->bt->snap[k], 1);
+    }
+
+    /* each thread has its own GLPK environment */
+    glp_free_env();
+
+    return NULL;
+}
+
+/* returns the number of threads started */
+static int batchThreads(glpkBatch *bt, int nw) {
+
+    struct batchCtx ctx;
+    pthread_t *tid;
+    pthread_attr_t attr;
+    int w, nstarted = 0;
+
+    tid = malloc((size_t) nw * sizeof(pthread_t));
+    if (tid == NULL) {
+        return 0;
+    }
+
+    ctx.bt   = bt;
+    ctx.next = 0;
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    /* the MathProg translator is recursive, secondary threads may have a
+       small default stack */
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 8 * 1024 * 1024);
+
+    for (w = 0; w < nw; w++) {
+        if (pthread_create(&tid[nstarted], &attr, batchThread, &ctx) == 0) {
+            nstarted++;
+        }
+    }
+    for (w = 0; w < nstarted; w++) {
+        pthread_join(tid[w], NULL);
+    }
+
+    pthread_attr_destroy(&attr);
+    pthread_mutex_destroy(&ctx.lock);
+    free(tid);
+
+    return nstarted;
+}
+
+#endif /* BATCH_THREADS */
+
+
+/* -------------------------------------------------------------------------- */
+/* forked processes                                                           */
+/* -------------------------------------------------------------------------- */
+
+#ifdef BATCH_FORK
+
+/* a worker process sends one record per instance: the header, followed by
+   len bytes of snapshot data */
+struct batchRec {
+    int idx;
+    int status;
+    size_t len;
+};
+
+static int writeAll(int fd, const void *src, size_t n) {
+
+    const unsigned char *p = src;
+    ssize_t nw;
+
+    while (n > 0) {
+        nw = write(fd, p, n);
+        if (nw < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 1;
+        }
+        p += nw;
+        n -= (size_t) nw;
+    }
+
+    return 0;
+}
+
+static int readAll(int fd, void *dest, size_t n) {
+
+    unsigned char *p = dest;
+    ssize_t nr;
+
+    while (n > 0) {
+        nr = read(fd, p, n);
+        if (nr < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 1;
+        }
+        if (nr == 0) {
+            return 1;
+        }
+        p += nr;
+        n -= (size_t) nr;
+    }
+
+    return 0;
+}
+
+static void batchChild(glpkBatch *bt, int first, int step, int fd) {
+
+    struct batchRec rec;
+    glpkBuf buf = { NULL, 0, 0 };
+    int k;
+
+    for (k = first; k < bt->ninst; k += step) {
+        memset(&rec, 0, sizeof(rec));
+        rec.idx    = k;
+        rec.status = batchBuild(bt, k, &buf, 1);
+        rec.len    = (rec.status == GLPK_BATCH_OK) ? buf.len : 0;
+        if ( writeAll(fd, &rec, sizeof(rec)) ||
+             ( (rec.len > 0) && writeAll(fd, buf.data, rec.len) ) ) {
+            break;
+        }
+    }
+
+    glpkBufFree(&buf);
+    close(fd);
+}
+
+/* read one record, returns nonzero at the end of the stream */
+static int batchReceive(glpkBatch *bt, int fd) {
+
+    struct batchRec rec;
+    unsigned char chunk[65536];
+    glpkBuf *buf;
+    size_t left, n;
+
+    if (readAll(fd, &rec, sizeof(rec)) != 0) {
+        return 1;
+    }
+    if ( (rec.idx < 0) || (rec.idx >= bt->ninst) ) {
+        return 1;
+    }
+
+    buf = &bt->snap[rec.idx];
+    buf->len = 0;
+
+    for (left = rec.len; left > 0; left -= n) {
+        n = (left < sizeof(chunk)) ? left : sizeof(chunk);
+        if ( readAll(fd, chunk, n) || glpkBufPut(buf, chunk, n) ) {
+            glpkBufFree(buf);
+            return 1;
+        }
+    }
+    bt->status[rec.idx] = rec.status;
+
+    return 0;
+}
+
+static void batchFork(glpkBatch *bt, int nw) {
+
+    struct pollfd *pfd;
+    pid_t *pid;
+    int fds[2];
+    int w, v, open = 0;
+
+    pfd = malloc((size_t) nw * sizeof(struct pollfd));
+    pid = malloc((size_t) nw * sizeof(pid_t));
+    if ( (pfd == NULL) || (pid == NULL) ) {
+        free(pfd);
+        free(pid);
+        batchSerial(bt, 0, 1);
+        return;
+    }
+
+    for (w = 0; w < nw; w++) {
+        pfd[w].fd     = -1;
+        pfd[w].events = POLLIN;
+        pid[w]        = -1;
+        if (pipe(fds) != 0) {
+            continue;
+        }
+        pid[w] = fork();
+        if (pid[w] == 0) {
+            /* worker: do not keep the pipes of the other workers open */
+            close(fds[0]);
+            for (v = 0; v < w; v++) {
+                if (pfd[v].fd >= 0) {
+                    close(pfd[v].fd);
+                }
+            }
+            batchChild(bt, w, nw, fds[1]);
+            _exit(0);
+        }
+        close(fds[1]);
+        if (pid[w] < 0) {
+            close(fds[0]);
+            continue;
+        }
+        pfd[w].fd = fds[0];
+        open++;
+    }
+
+    while (open > 0) {
+        if (poll(pfd, (nfds_t) nw, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (w = 0; w < nw; w++) {
+            if ( (pfd[w].fd >= 0) && (pfd[w].revents != 0) ) {
+                if (batchReceive(bt, pfd[w].fd) != 0) {
+                    close(pfd[w].fd);
+                    pfd[w].fd = -1;
+                    open--;
+                }
+            }
+        }
+    }
+
+    for (w = 0; w < nw; w++) {
+        if (pfd[w].fd >= 0) {
+            close(pfd[w].fd);
+        }
+        if (pid[w] > 0) {
+            while ( (waitpid(pid[w], NULL, 0) < 0) && (errno == EINTR) ) {
+                ;
+            }
+        }
+        else {
+            /* no worker process for this share, do it here */
+            batchSerial(bt, w, nw);
+        }
+    }
+
+    free(pfd);
+    free(pid);
+}
+
+#endif /* BATCH_FORK */
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkBatchRun(glpkBatch *bt, int nworkers) {
+
+    int k;
+    int nw = (nworkers < bt->ninst) ? nworkers : bt->ninst;
+
+    for (k = 0; k < bt->ninst; k++) {
+        bt->status[k] = GLPK_BATCH_ELOST;
+    }
+
+    if (nw <= 1) {
+        batchSerial(bt, 0, 1);
+        return GLPK_BATCH_SERIAL;
+    }
+
+#ifdef BATCH_THREADS
+    if (glpkBatchThreadSafe()) {
+        if (batchThreads(bt, nw) > 0) {
+            return GLPK_BATCH_THREADS;
+        }
+    }
+#endif
+
+#ifdef BATCH_FORK
+    batchFork(bt, nw);
+    return GLPK_BATCH_FORK;
+#else
+    batchSerial(bt, 0, 1);
+    return GLPK_BATCH_SERIAL;
+#endif
+}
@@ -0,0 +1,66 @@
+/* glpkBatch.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* parallel generation of MathProg instances                                  */
+/* -------------------------------------------------------------------------- */
+
+/* Every instance is translated in its own glp_tran and stored as snapshot
+   (see glpkSnapshot.h), because a glp_prob created in a worker thread
+   belongs to the GLPK environment of that thread. Workers are threads if
+   GLPK was built with thread local storage, forked processes otherwise. The
+   routines never call into R. */
+
+/* status of an instance */
+#define GLPK_BATCH_OK     0  /* snapshot created */
+#define GLPK_BATCH_EMODEL 1  /* error in model section */
+#define GLPK_BATCH_EDATA  2  /* error in data section */
+#define GLPK_BATCH_EGEN   3  /* error during generation */
+#define GLPK_BATCH_EGLPK  4  /* GLPK runtime error */
+#define GLPK_BATCH_ESNAP  5  /* snapshot could not be written or read */
+#define GLPK_BATCH_ELOST  6  /* worker process terminated */
+
+/* how the workers were run */
+#define GLPK_BATCH_SERIAL  0
+#define GLPK_BATCH_THREADS 1
+#define GLPK_BATCH_FORK    2
+
+typedef struct {
+    const char *model;       /* model file */
+    int skip;                /* passed to glp_mpl_read_model */
+    int ninst;               /* number of instances */
+    const char **dfiles;     /* data files of all instances */
+    const int *dbeg;         /* files of instance k are dfiles[dbeg[k]] up to
+                                dfiles[dbeg[k + 1] - 1] */
+    const char **outfiles;   /* snapshot files, or NULL to keep them in snap */
+    glpkBuf *snap;           /* ninst snapshots */
+    int *status;             /* ninst status codes */
+} glpkBatch;
+
+/* is GLPK safe to use from several threads */
+int glpkBatchThreadSafe(void);
+
+/* build all instances using up to nworkers workers, returns the mode used */
+int glpkBatchRun(glpkBatch *bt, int nworkers);
@@ -0,0 +1,300 @@
+/* glpkBlock.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkBlock.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* solves                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    glp_prob *P;
+    glp_smcp parm;
+    glpkProbInfo *info;
+    int n;
+    double tol;
+    int *open;               /* nonzero while not proven unblocked */
+    int nopen;
+    glpkBlockStat *st;
+} blockCtx;
+
+/* uniform on (0, 1), splitmix64 */
+static double blockUnif(uint64_t *s) {
+
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+
+    return ((double) (z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/* solve and close the columns nonzero in a feasible solution; *nnew
+   receives the number of columns closed */
+static int blockSolve(blockCtx *bc, int dir, int *nnew) {
+
+    int j, ret;
+
+    *nnew = 0;
+
+    glp_set_obj_dir(bc->P, dir);
+    ret = glpkSolveSimplex(bc->P, &bc->parm, bc->info);
+    bc->st->nlp++;
+
+    /* a failed solve proves nothing, the caller stops */
+    if (ret != 0) {
+        return ret;
+    }
+
+    if (glp_get_prim_stat(bc->P) == GLP_FEAS) {
+        for (j = 1; j <= bc->n; j++) {
+            if ( (bc->open[j]) &&
+                 (fabs(glp_get_col_prim(bc->P, j)) > bc->tol) ) {
+                bc->open[j] = 0;
+                bc->nopen--;
+                (*nnew)++;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* optimize column j alone; it stays open only if the solve ended optimal
+   with column j at zero, every other outcome but unboundedness is an
+   error */
+static int blockSingle(blockCtx *bc, int j, int dir) {
+
+    int nnew, stat, ret;
+
+    ret = blockSolve(bc, dir, &nnew);
+    bc->st->nsingle++;
+
+    if ( (ret != 0) || (!bc->open[j]) ) {
+        return ret;
+    }
+
+    stat = glp_get_status(bc->P);
+    if (stat == GLP_UNBND) {
+        bc->open[j] = 0;
+        bc->nopen--;
+    }
+    else if (stat != GLP_OPT) {
+        ret = GLP_EFAIL;
+    }
+    else if (fabs(glp_get_col_prim(bc->P, j)) > bc->tol) {
+        bc->open[j] = 0;
+        bc->nopen--;
+    }
+
+    return ret;
+}
+
+/* objective coefficient c on the open columns (-2 for random ones), zero
+   elsewhere */
+static void blockObj(blockCtx *bc, double c, uint64_t *rng) {
+
+    int j;
+
+    for (j = 1; j <= bc->n; j++) {
+        if (!bc->open[j]) {
+            glp_set_obj_coef(bc->P, j, 0);
+        }
+        else {
+            glp_set_obj_coef(bc->P, j,
+                             (c < -1) ? 2 * blockUnif(rng) - 1 : c);
+        }
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkBlocked(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                double tol, int nrandom, unsigned int seed, int *blocked,
+                glpkBlockStat *st) {
+
+    blockCtx bc;
+    double *c0;
+    uint64_t rng = (uint64_t) seed;
+    int dir = glp_get_obj_dir(P);
+    int j, k, nmax, nmin, ret = 0;
+
+    st->nlp      = 0;
+    st->nsingle  = 0;
+    st->nblocked = 0;
+
+    bc.P     = P;
+    bc.parm  = *parm;
+    bc.info  = info;
+    bc.n     = glp_get_num_cols(P);
+    bc.tol   = tol;
+    bc.nopen = bc.n;
+    bc.st    = st;
+
+    bc.parm.meth     = GLP_PRIMAL;
+    bc.parm.presolve = GLP_OFF;
+
+    c0      = malloc(((size_t) bc.n + 1) * sizeof(double));
+    bc.open = malloc(((size_t) bc.n + 1) * sizeof(int));
+    if ( (c0 == NULL) || (bc.open == NULL) ) {
+        free(c0);
+        free(bc.open);
+        return -1;
+    }
+    for (j = 1; j <= bc.n; j++) {
+        c0[j] = glp_get_obj_coef(P, j);
+        bc.open[j] = 1;
+    }
+
+    /* feasibility with the objective of the user */
+    ret = blockSolve(&bc, dir, &nmax);
+    if (ret == 0) {
+        if (glp_get_status(P) == GLP_NOFEAS) {
+            ret = GLP_ENOPFS;
+        }
+        else if (glp_get_prim_stat(P) != GLP_FEAS) {
+            ret = GLP_EFAIL;
+        }
+    }
+
+    /* sum of the open columns, both directions */
+    do {
+        if (ret != 0) {
+            break;
+        }
+        blockObj(&bc, 1, &rng);
+        ret = blockSolve(&bc, GLP_MAX, &nmax);
+        if (ret == 0) {
+            blockObj(&bc, 1, &rng);
+            ret = blockSolve(&bc, GLP_MIN, &nmin);
+        }
+    } while ( (ret == 0) && (bc.nopen > 0) && (nmax + nmin > 0) );
+
+    for (k = 0; (k < nrandom) && (ret == 0) && (bc.nopen > 0); k++) {
+        blockObj(&bc, -2, &rng);
+        ret = blockSolve(&bc, GLP_MAX, &nmax);
+    }
+
+    /* the remaining columns one at a time */
+    if (ret == 0) {
+        blockObj(&bc, 0, &rng);
+    }
+    for (j = 1; (j <= bc.n) && (ret == 0); j++) {
+        if (!bc.open[j]) {
+            continue;
+        }
+        glp_set_obj_coef(P, j, 1);
+        ret = blockSingle(&bc, j, GLP_MAX);
+        if ( (ret == 0) && (bc.open[j]) ) {
+            ret = blockSingle(&bc, j, GLP_MIN);
+        }
+        glp_set_obj_coef(P, j, 0);
+    }
+
+    for (j = 1; j <= bc.n; j++) {
+        blocked[j-1] = ( (ret == 0) && (bc.open[j]) );
+        st->nblocked += blocked[j-1];
+        glp_set_obj_coef(P, j, c0[j]);
+    }
+    glp_set_obj_dir(P, dir);
+
+    free(c0);
+    free(bc.open);
+
+    return ret;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* deletion                                                                   */
+/* -------------------------------------------------------------------------- */
+
+int glpkBlockedDelete(glp_prob *P, const int *blocked, int *colmap,
+                      int *rowmap, int *ncols, int *nrows) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int *num;
+    int i, j, nd, nbas;
+
+    num = malloc(((size_t) ( (m > n) ? m : n ) + 1) * sizeof(int));
+    if (num == NULL) {
+        return 1;
+    }
+
+    nd = 0;
+    *ncols = 0;
+    for (j = 1; j <= n; j++) {
+        if (blocked[j-1]) {
+            num[++nd] = j;
+        }
+        else {
+            colmap[(*ncols)++] = j;
+        }
+    }
+    if (nd > 0) {
+        glp_del_cols(P, nd, num);
+    }
+
+    nd = 0;
+    *nrows = 0;
+    for (i = 1; i <= m; i++) {
+        if (glp_get_mat_row(P, i, NULL, NULL) == 0) {
+            num[++nd] = i;
+        }
+        else {
+            rowmap[(*nrows)++] = i;
+        }
+    }
+    if (nd > 0) {
+        glp_del_rows(P, nd, num);
+    }
+
+    /* deleted columns and rows may have been basic */
+    nbas = 0;
+    for (i = 1; i <= *nrows; i++) {
+        nbas += (glp_get_row_stat(P, i) == GLP_BS);
+    }
+    for (j = 1; j <= *ncols; j++) {
+        nbas += (glp_get_col_stat(P, j) == GLP_BS);
+    }
+    if (nbas != *nrows) {
+        glp_std_basis(P);
+    }
+
+    free(num);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/* glpkBlock.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* blocked columns                                                            */
+/* -------------------------------------------------------------------------- */
+
+/* A column is blocked if it is zero in every feasible point. Every feasible
+   solution found proves the columns nonzero in it unblocked, so few LPs
+   cover most columns: first the sum of the open columns is maximized and
+   minimized until no new column is found, then nrandom random objectives
+   over the open columns are optimized; only the remaining columns get their
+   own maximization and minimization. All solves go through glpkSolveSimplex
+   (primal, presolver off), each starting from the previous basis. */
+
+typedef struct {
+    int nlp;                 /* LPs solved */
+    int nsingle;             /* of which for single columns */
+    int nblocked;
+} glpkBlockStat;
+
+/* blocked (n elements) receives 1 for blocked columns, 0 otherwise; values
+   with absolute value up to tol are zero. The objective of P is restored.
+   Returns 0, GLP_ENOPFS if P has no feasible solution, the nonzero return
+   code of a failed solve (GLPK_EINTR and GLPK_EBUDGET included) or
+   GLP_EFAIL if a single column solve did not end optimal or unbounded
+   (blocked is incomplete then, and all zero), -1 if out of memory. */
+int glpkBlocked(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                double tol, int nrandom, unsigned int seed, int *blocked,
+                glpkBlockStat *st);
+
+/* Delete the blocked columns and the rows without nonzeros afterwards.
+   colmap and rowmap (n and m elements) receive the original indices of the
+   remaining columns and rows, *ncols and *nrows their numbers. If the
+   basis of P lost basic variables, it is replaced by the standard basis.
+   Returns nonzero if out of memory. */
+int glpkBlockedDelete(glp_prob *P, const int *blocked, int *colmap,
+                      int *rowmap, int *ncols, int *nrows);
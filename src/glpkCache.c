@@ -0,0 +1,363 @@
+/* glpkCache.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "glpkSnapshot.h"
+#include "glpkCache.h"
+
+
+/* the cache is a most recently used first list of snapshots, optionally
+   backed by files <dir>/<key>.glpksnap */
+struct cacheEntry {
+    char key[GLPK_CACHE_KEYLEN + 1];
+    unsigned char *data;
+    size_t len;
+    struct cacheEntry *next;
+};
+
+static struct cacheEntry *cacheHead = NULL;
+static int cacheOn      = 0;
+static int cacheMaxEnt  = 32;
+static int cacheNumEnt  = 0;
+static char *cacheDir   = NULL;
+static double cacheHits = 0;
+static double cacheMiss = 0;
+
+
+/* -------------------------------------------------------------------------- */
+/* hashing                                                                    */
+/* -------------------------------------------------------------------------- */
+
+void glpkHashInit(glpkHash *h) {
+    *h = 14695981039346656037ULL;
+}
+
+void glpkHashBytes(glpkHash *h, const void *data, size_t n) {
+
+    const unsigned char *p = data;
+    glpkHash hv = *h;
+    size_t k;
+
+    for (k = 0; k < n; k++) {
+        hv ^= (glpkHash) p[k];
+        hv *= 1099511628211ULL;
+    }
+    *h = hv;
+}
+
+int glpkHashFile(glpkHash *h, const char *fname) {
+
+    FILE *fh;
+    unsigned char chunk[65536];
+    size_t nr, total = 0;
+    int err;
+
+    fh = fopen(fname, "rb");
+    if (fh == NULL) {
+        return 1;
+    }
+    while ( (nr = fread(chunk, 1, sizeof(chunk), fh)) > 0 ) {
+        glpkHashBytes(h, chunk, nr);
+        total += nr;
+    }
+    err = ferror(fh);
+    fclose(fh);
+
+    /* terminate the file content, so that "ab" + "c" differs from "a" + "bc" */
+    glpkHashBytes(h, &total, sizeof(total));
+
+    return err;
+}
+
+void glpkHashKey(glpkHash h, char key[GLPK_CACHE_KEYLEN + 1]) {
+    snprintf(key, GLPK_CACHE_KEYLEN + 1, "%016llx", h);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* cache                                                                      */
+/* -------------------------------------------------------------------------- */
+
+static char *cacheFileName(const char *key) {
+
+    size_t len;
+    char *fname;
+
+    len = strlen(cacheDir) + GLPK_CACHE_KEYLEN + 11;
+    fname = malloc(len);
+    if (fname != NULL) {
+        snprintf(fname, len, "%s/%s.glpksnap", cacheDir, key);
+    }
+
+    return fname;
+}
+
+static void cacheDropTail(void) {
+
+    struct cacheEntry *ent = cacheHead;
+    struct cacheEntry *prev = NULL;
+
+    while ( (ent != NULL) && (ent->next != NULL) ) {
+        prev = ent;
+        ent = ent->next;
+    }
+    if (ent != NULL) {
+        if (prev == NULL) {
+            cacheHead = NULL;
+        }
+        else {
+            prev->next = NULL;
+        }
+        free(ent->data);
+        free(ent);
+        cacheNumEnt--;
+    }
+}
+
+/* remove the entry of key from memory and its file from disk */
+static void cacheRemove(const char *key) {
+
+    struct cacheEntry *ent = cacheHead;
+    struct cacheEntry *prev = NULL;
+    char *fname;
+
+    while (ent != NULL) {
+        if (strcmp(ent->key, key) == 0) {
+            if (prev == NULL) {
+                cacheHead = ent->next;
+            }
+            else {
+                prev->next = ent->next;
+            }
+            free(ent->data);
+            free(ent);
+            cacheNumEnt--;
+            break;
+        }
+        prev = ent;
+        ent = ent->next;
+    }
+
+    if (cacheDir != NULL) {
+        fname = cacheFileName(key);
+        if (fname != NULL) {
+            remove(fname);
+            free(fname);
+        }
+    }
+}
+
+static void cacheAdd(const char *key, unsigned char *data, size_t len) {
+
+    struct cacheEntry *ent;
+
+    ent = malloc(sizeof(struct cacheEntry));
+    if (ent == NULL) {
+        free(data);
+        return;
+    }
+    memcpy(ent->key, key, GLPK_CACHE_KEYLEN + 1);
+    ent->data = data;
+    ent->len  = len;
+    ent->next = cacheHead;
+    cacheHead = ent;
+    cacheNumEnt++;
+
+    while (cacheNumEnt > cacheMaxEnt) {
+        cacheDropTail();
+    }
+}
+
+void glpkCacheSetup(int enable, const char *dir, int maxent) {
+
+    cacheOn = (enable != 0);
+    cacheMaxEnt = (maxent > 0) ? maxent : 1;
+
+    free(cacheDir);
+    cacheDir = NULL;
+    if ( (dir != NULL) && (dir[0] != '\0') ) {
+        cacheDir = malloc(strlen(dir) + 1);
+        if (cacheDir != NULL) {
+            strcpy(cacheDir, dir);
+        }
+    }
+
+    while (cacheNumEnt > cacheMaxEnt) {
+        cacheDropTail();
+    }
+}
+
+int glpkCacheEnabled(void) {
+    return cacheOn;
+}
+
+const unsigned char *glpkCacheLookup(const char *key, size_t *len) {
+
+    struct cacheEntry *ent = cacheHead;
+    struct cacheEntry *prev = NULL;
+    glpkBuf buf = { NULL, 0, 0 };
+    char *fname;
+
+    while (ent != NULL) {
+        if (strcmp(ent->key, key) == 0) {
+            /* move to front */
+            if (prev != NULL) {
+                prev->next = ent->next;
+                ent->next  = cacheHead;
+                cacheHead  = ent;
+            }
+            cacheHits++;
+            *len = ent->len;
+            return ent->data;
+        }
+        prev = ent;
+        ent = ent->next;
+    }
+
+    if (cacheDir != NULL) {
+        fname = cacheFileName(key);
+        if ( (fname != NULL) && (glpkSnapLoad(&buf, fname) == 0) ) {
+            free(fname);
+            cacheAdd(key, buf.data, buf.len);
+            if ( (cacheHead != NULL) && (cacheHead->data == buf.data) ) {
+                cacheHits++;
+                *len = cacheHead->len;
+                return cacheHead->data;
+            }
+        }
+        else {
+            free(fname);
+            glpkBufFree(&buf);
+        }
+    }
+
+    cacheMiss++;
+    *len = 0;
+
+    return NULL;
+}
+
+void glpkCacheEvict(const char *key) {
+    cacheRemove(key);
+}
+
+void glpkCacheInsert(const char *key, unsigned char *data, size_t len) {
+
+    glpkBuf buf;
+    char *fname;
+
+    /* one entry per key */
+    cacheRemove(key);
+
+    if (cacheDir != NULL) {
+        buf.data = data;
+        buf.len  = len;
+        buf.cap  = len;
+        fname = cacheFileName(key);
+        if (fname != NULL) {
+            /* a failing write only means the entry is not persistent */
+            glpkSnapSave(&buf, fname);
+            free(fname);
+        }
+    }
+
+    cacheAdd(key, data, len);
+}
+
+/* is name a cache file: <key>.glpksnap, key in lower case hex digits */
+static int cacheIsFile(const char *name) {
+
+    int k;
+
+    if ( (strlen(name) != GLPK_CACHE_KEYLEN + 9) ||
+         (strcmp(name + GLPK_CACHE_KEYLEN, ".glpksnap") != 0) ) {
+        return 0;
+    }
+    for (k = 0; k < GLPK_CACHE_KEYLEN; k++) {
+        if (strchr("0123456789abcdef", name[k]) == NULL) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void glpkCacheClear(int disk) {
+
+    struct cacheEntry *ent;
+    DIR *dh;
+    struct dirent *de;
+    char key[GLPK_CACHE_KEYLEN + 1];
+    char *fname;
+
+    while (cacheHead != NULL) {
+        ent = cacheHead;
+        cacheHead = ent->next;
+        free(ent->data);
+        free(ent);
+    }
+    cacheNumEnt = 0;
+
+    /* also the files of earlier sessions, which are not in memory */
+    if ( disk && (cacheDir != NULL) ) {
+        dh = opendir(cacheDir);
+        if (dh != NULL) {
+            while ( (de = readdir(dh)) != NULL ) {
+                if (cacheIsFile(de->d_name)) {
+                    memcpy(key, de->d_name, GLPK_CACHE_KEYLEN);
+                    key[GLPK_CACHE_KEYLEN] = '\0';
+                    fname = cacheFileName(key);
+                    if (fname != NULL) {
+                        remove(fname);
+                        free(fname);
+                    }
+                }
+            }
+            closedir(dh);
+        }
+    }
+
+    cacheHits   = 0;
+    cacheMiss   = 0;
+}
+
+void glpkCacheInfo(int *entries, double *bytes, double *hits, double *misses,
+                   const char **dir) {
+
+    struct cacheEntry *ent;
+    double sz = 0;
+
+    for (ent = cacheHead; ent != NULL; ent = ent->next) {
+        sz += (double) ent->len;
+    }
+
+    *entries = cacheNumEnt;
+    *bytes   = sz;
+    *hits    = cacheHits;
+    *misses  = cacheMiss;
+    *dir     = cacheDir;
+}
@@ -0,0 +1,73 @@
+/* glpkCache.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stddef.h>
+
+
+/* -------------------------------------------------------------------------- */
+/* cache of generated MathProg problems                                       */
+/* -------------------------------------------------------------------------- */
+
+/* length of a cache key (hex digits of a 64 bit FNV-1a hash) */
+#define GLPK_CACHE_KEYLEN 16
+
+/* 64 bit FNV-1a hash */
+typedef unsigned long long glpkHash;
+
+/* start a new hash */
+void glpkHashInit(glpkHash *h);
+
+/* add a block of bytes to the hash */
+void glpkHashBytes(glpkHash *h, const void *data, size_t n);
+
+/* add the content of a file to the hash, returns zero on success */
+int glpkHashFile(glpkHash *h, const char *fname);
+
+/* format the hash as cache key */
+void glpkHashKey(glpkHash h, char key[GLPK_CACHE_KEYLEN + 1]);
+
+/* enable/disable the cache, dir may be NULL (memory only) */
+void glpkCacheSetup(int enable, const char *dir, int maxent);
+
+/* is the cache enabled */
+int glpkCacheEnabled(void);
+
+/* look up a snapshot, returns NULL if the key is not cached */
+const unsigned char *glpkCacheLookup(const char *key, size_t *len);
+
+/* remove an entry (after its snapshot could not be read) from memory and
+   disk */
+void glpkCacheEvict(const char *key);
+
+/* store a snapshot, the cache takes over the memory in data; an entry with
+   the same key is replaced */
+void glpkCacheInsert(const char *key, unsigned char *data, size_t len);
+
+/* remove all entries from memory and optionally all cache files from the
+   cache directory */
+void glpkCacheClear(int disk);
+
+/* cache statistics */
+void glpkCacheInfo(int *entries, double *bytes, double *hits, double *misses,
+                   const char **dir);
@@ -0,0 +1,321 @@
+/* glpkCross.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkCross.h"
+
+/* a variable is on its bound within this relative distance */
+#define CROSS_TOL 1e-7
+
+static int itCnt(glp_prob *P) {
+#ifdef HAVE_GLP_GET_IT_CNT
+    return glp_get_it_cnt(P);
+#else
+    return -1;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* candidates                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/* variable k is row k (1 <= k <= m) or column k - m */
+typedef struct {
+    double score;
+    int k;
+} crossKey;
+
+typedef struct {
+    glp_prob *P;
+    int m;
+    int n;
+    double *score;     /* > 0: candidate for the basis, larger is better */
+    int *stat;         /* nonbasic status */
+    crossKey *order;   /* variables by decreasing score */
+} crossCtx;
+
+/* the key is sorted along, so that the comparison needs no global data and
+   the crossover can run in several threads */
+static int cmpScore(const void *a, const void *b) {
+
+    const crossKey *ka = a;
+    const crossKey *kb = b;
+
+    if (ka->score > kb->score) {
+        return -1;
+    }
+    if (ka->score < kb->score) {
+        return 1;
+    }
+    return (ka->k - kb->k);
+}
+
+/* score and nonbasic status of one variable from its interior point
+   value x and reduced cost d */
+static void rateVar(int type, double lb, double ub, double x, double d,
+                    double *score, int *stat) {
+
+    double dl, du;
+
+    switch (type) {
+        case GLP_FR:
+            *stat  = GLP_NF;
+            *score = 1.0 + fabs(x);
+            return;
+        case GLP_FX:
+            *stat  = GLP_NS;
+            *score = -1.0;
+            return;
+        default:
+            break;
+    }
+
+    dl = (type == GLP_UP) ? HUGE_VAL : (x - lb) / (1.0 + fabs(lb));
+    du = (type == GLP_LO) ? HUGE_VAL : (ub - x) / (1.0 + fabs(ub));
+
+    *stat  = (dl <= du) ? GLP_NL : GLP_NU;
+    *score = ( (dl < du) ? dl : du ) - fabs(d);
+
+    if ( (dl < CROSS_TOL) || (du < CROSS_TOL) ) {
+        /* on a bound */
+        *score = -fabs(d) - ( (dl < du) ? dl : du );
+    }
+}
+
+static int rateAll(crossCtx *cx) {
+
+    glp_prob *P = cx->P;
+    int i, j, k, ncand = 0;
+
+    for (i = 1; i <= cx->m; i++) {
+        rateVar(glp_get_row_type(P, i), glp_get_row_lb(P, i),
+                glp_get_row_ub(P, i), glp_ipt_row_prim(P, i),
+                glp_ipt_row_dual(P, i), &cx->score[i], &cx->stat[i]);
+    }
+    for (j = 1; j <= cx->n; j++) {
+        rateVar(glp_get_col_type(P, j), glp_get_col_lb(P, j),
+                glp_get_col_ub(P, j), glp_ipt_col_prim(P, j),
+                glp_ipt_col_dual(P, j), &cx->score[cx->m+j],
+                &cx->stat[cx->m+j]);
+    }
+
+    for (k = 1; k <= cx->m + cx->n; k++) {
+        cx->order[k-1].score = cx->score[k];
+        cx->order[k-1].k     = k;
+        if (cx->score[k] > 0) {
+            ncand++;
+        }
+    }
+
+    qsort(cx->order, (size_t) (cx->m + cx->n), sizeof(crossKey), cmpScore);
+
+    return ncand;
+}
+
+static void setStat(crossCtx *cx, int k, int stat) {
+
+    if (k <= cx->m) {
+        glp_set_row_stat(cx->P, k, stat);
+    }
+    else {
+        glp_set_col_stat(cx->P, k - cx->m, stat);
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* basis                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/* the m best variables basic; returns the number of candidates made basic */
+static int directBasis(crossCtx *cx) {
+
+    int k, nb = 0;
+
+    for (k = 0; k < cx->m + cx->n; k++) {
+        if (k < cx->m) {
+            setStat(cx, cx->order[k].k, GLP_BS);
+            if (cx->order[k].score > 0) {
+                nb++;
+            }
+        }
+        else {
+            setStat(cx, cx->order[k].k, cx->stat[cx->order[k].k]);
+        }
+    }
+
+    return nb;
+}
+
+/* Triangular crash: a candidate becomes basic if it has a large enough
+   element in a row no basic variable taken before has an element in; that
+   row is its pivot. Ordered by pivot rows, the basic columns form an upper
+   triangular matrix with nonzero diagonal, rows without pivot are covered
+   by their auxiliary variables. Returns the number of candidates made
+   basic, -1 if out of memory. */
+static int crashBasis(crossCtx *cx) {
+
+    char *touched;
+    int *ind;
+    double *val;
+    int k, v, t, len, piv, nb = 0;
+    double amax, apiv;
+
+    touched = calloc((size_t) cx->m + 1, sizeof(char));
+    ind     = malloc(((size_t) cx->m + 1) * sizeof(int));
+    val     = malloc(((size_t) cx->m + 1) * sizeof(double));
+    if ( (touched == NULL) || (ind == NULL) || (val == NULL) ) {
+        free(touched);
+        free(ind);
+        free(val);
+        return -1;
+    }
+
+    for (k = 1; k <= cx->m + cx->n; k++) {
+        setStat(cx, k, cx->stat[k]);
+    }
+
+    for (k = 0; k < cx->m + cx->n; k++) {
+        v = cx->order[k].k;
+        if (cx->score[v] <= 0) {
+            break;
+        }
+        if (v <= cx->m) {
+            /* auxiliary variable, a unit column */
+            if (!touched[v]) {
+                touched[v] = 1;
+                glp_set_row_stat(cx->P, v, GLP_BS);
+                nb++;
+            }
+            continue;
+        }
+
+        len  = glp_get_mat_col(cx->P, v - cx->m, ind, val);
+        amax = 0;
+        for (t = 1; t <= len; t++) {
+            if (fabs(val[t]) > amax) {
+                amax = fabs(val[t]);
+            }
+        }
+        piv  = 0;
+        apiv = 0.01 * amax;
+        for (t = 1; t <= len; t++) {
+            if ( (!touched[ind[t]]) && (fabs(val[t]) > apiv) ) {
+                piv  = ind[t];
+                apiv = fabs(val[t]);
+            }
+        }
+        if ( (piv == 0) || (amax == 0) ) {
+            continue;
+        }
+        for (t = 1; t <= len; t++) {
+            touched[ind[t]] = 1;
+        }
+        glp_set_col_stat(cx->P, v - cx->m, GLP_BS);
+        nb++;
+        /* the pivot row does not get its auxiliary variable */
+        touched[piv] = 2;
+    }
+
+    for (k = 1; k <= cx->m; k++) {
+        if (touched[k] != 2) {
+            glp_set_row_stat(cx->P, k, GLP_BS);
+        }
+    }
+
+    free(touched);
+    free(ind);
+    free(val);
+
+    return nb;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkCrossBasis(glp_prob *P, glpkCrossStat *st) {
+
+    crossCtx cx;
+    int ret = 0;
+
+    st->ncand  = 0;
+    st->nbasic = 0;
+    st->crash  = 0;
+    st->iter   = -1;
+
+    cx.P     = P;
+    cx.m     = glp_get_num_rows(P);
+    cx.n     = glp_get_num_cols(P);
+    cx.score = malloc(((size_t) cx.m + cx.n + 1) * sizeof(double));
+    cx.stat  = malloc(((size_t) cx.m + cx.n + 1) * sizeof(int));
+    cx.order = malloc(((size_t) cx.m + cx.n + 1) * sizeof(crossKey));
+
+    if ( (cx.score == NULL) || (cx.stat == NULL) || (cx.order == NULL) ) {
+        ret = 1;
+    }
+    else if (cx.m > 0) {
+        st->ncand  = rateAll(&cx);
+        st->nbasic = directBasis(&cx);
+        if (glp_factorize(P) != 0) {
+            st->crash  = 1;
+            st->nbasic = crashBasis(&cx);
+            if ( (st->nbasic < 0) || (glp_factorize(P) != 0) ) {
+                glp_std_basis(P);
+                st->nbasic = 0;
+            }
+        }
+    }
+
+    free(cx.score);
+    free(cx.stat);
+    free(cx.order);
+
+    return ret;
+}
+
+int glpkCrossover(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                  glpkCrossStat *st) {
+
+    glp_smcp lparm = *parm;
+    int ret, it0;
+
+    /* without memory for the crossover, solve from the current basis */
+    glpkCrossBasis(P, st);
+
+    /* the presolver would not use the basis */
+    lparm.presolve = GLP_OFF;
+
+    it0 = itCnt(P);
+    ret = glpkSolveSimplex(P, &lparm, info);
+    st->iter = (it0 < 0) ? -1 : itCnt(P) - it0;
+
+    return ret;
+}
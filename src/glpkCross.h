@@ -0,0 +1,53 @@
+/* glpkCross.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* crossover from an interior point solution to a basis                       */
+/* -------------------------------------------------------------------------- */
+
+/* The interior point solution stored in the problem object is turned into a
+   basis: variables strictly between their bounds (and with small reduced
+   cost) become basic in order of their distance to the bounds, all others
+   are nonbasic on their nearest bound. If the basis matrix is singular,
+   the basis is rebuilt as triangular crash in the same order, so that it is
+   nonsingular by construction, rows without pivot get their auxiliary
+   variable basic. The simplex method then finishes from that basis. */
+
+typedef struct {
+    int ncand;    /* variables strictly between their bounds */
+    int nbasic;   /* of them basic in the installed basis */
+    int crash;    /* nonzero if the triangular crash was needed */
+    int iter;     /* simplex iterations, -1 if unknown */
+} glpkCrossStat;
+
+/* install the basis; only calls GLPK, so that it can run in any thread
+   with its own GLPK environment. Returns nonzero if out of memory, then the
+   basis is not changed. */
+int glpkCrossBasis(glp_prob *P, glpkCrossStat *st);
+
+/* install the basis and run glp_simplex (through glpkSolveSimplex, with
+   presolver switched off); returns its return code */
+int glpkCrossover(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                  glpkCrossStat *st);
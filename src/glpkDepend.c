@@ -0,0 +1,492 @@
+/* glpkDepend.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkDepend.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* storage                                                                    */
+/* -------------------------------------------------------------------------- */
+
+/* growing list of sparse vectors */
+typedef struct {
+    int *ind;
+    double *val;
+    int len;
+    int cap;
+} depPool;
+
+static int poolPut(depPool *p, int ind, double val) {
+
+    int cap;
+    int *ni;
+    double *nv;
+
+    if (p->len == p->cap) {
+        cap = (p->cap > 0) ? 2 * p->cap : 1024;
+        ni = realloc(p->ind, (size_t) cap * sizeof(int));
+        if (ni == NULL) {
+            return 1;
+        }
+        p->ind = ni;
+        nv = realloc(p->val, (size_t) cap * sizeof(double));
+        if (nv == NULL) {
+            return 1;
+        }
+        p->val = nv;
+        p->cap = cap;
+    }
+
+    p->ind[p->len] = ind;
+    p->val[p->len] = val;
+    p->len++;
+
+    return 0;
+}
+
+/* pivot rows are applied in the order they were found */
+static void heapPush(int *h, int *nh, int k) {
+
+    int c = (*nh)++;
+    int p;
+
+    while ( (c > 0) && (h[p = (c - 1) / 2] > k) ) {
+        h[c] = h[p];
+        c = p;
+    }
+    h[c] = k;
+}
+
+static int heapPop(int *h, int *nh) {
+
+    int top = h[0];
+    int last = h[--(*nh)];
+    int c = 0, s;
+
+    while ( (s = 2 * c + 1) < *nh ) {
+        if ( (s + 1 < *nh) && (h[s+1] < h[s]) ) {
+            s++;
+        }
+        if (h[s] >= last) {
+            break;
+        }
+        h[c] = h[s];
+        c = s;
+    }
+    h[c] = last;
+
+    return top;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* factorization                                                              */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    int m;
+    int n;
+    double tol;
+    int *eq;                 /* equality rows, sparsest first */
+    int *colcnt;             /* nonzeros of column j in equality rows */
+    int *rind;               /* one row of P */
+    double *rval;
+    double *w;               /* dense work row */
+    int *wmark;
+    int *wlist;
+    int nw;
+    double *lam;             /* dense combination of original rows */
+    int *lmark;
+    int *llist;
+    int nl;
+    int *colpiv;             /* pivot row of column j, or -1 */
+    int *pc;                 /* pivot column, value and right hand side of */
+    double *pv;              /* pivot row k */
+    double *rb;
+    int *rbeg;               /* pivot row k without its pivot in R */
+    int *cbeg;               /* pivot row k as combination of rows in C */
+    int *heap;
+    int *inheap;
+    depPool R;
+    depPool C;
+    depPool L;               /* combinations of dependent rows */
+} depCtx;
+
+static void depWork(depCtx *dc, int j) {
+
+    if (!dc->wmark[j]) {
+        dc->wmark[j] = 1;
+        dc->w[j] = 0;
+        dc->wlist[dc->nw++] = j;
+    }
+}
+
+static void depLam(depCtx *dc, int i, double v) {
+
+    if (!dc->lmark[i]) {
+        dc->lmark[i] = 1;
+        dc->lam[i] = 0;
+        dc->llist[dc->nl++] = i;
+    }
+    dc->lam[i] += v;
+}
+
+/* pivot among the entries of at least a tenth of the largest one, in the
+   sparsest column */
+static int depPivot(const depCtx *dc, double drop) {
+
+    double amax = 0, a;
+    int t, j, p = 0;
+
+    for (t = 0; t < dc->nw; t++) {
+        a = fabs(dc->w[dc->wlist[t]]);
+        if (a > amax) {
+            amax = a;
+        }
+    }
+    if (amax <= drop) {
+        return 0;
+    }
+
+    for (t = 0; t < dc->nw; t++) {
+        j = dc->wlist[t];
+        a = fabs(dc->w[j]);
+        if (a < 0.1 * amax) {
+            continue;
+        }
+        if ( (p == 0) || (dc->colcnt[j] < dc->colcnt[p]) ||
+             ( (dc->colcnt[j] == dc->colcnt[p]) && (a > fabs(dc->w[p])) ) ) {
+            p = j;
+        }
+    }
+
+    return p;
+}
+
+/* reduce equality row i by the pivot rows; it becomes pivot row rank or
+   dependent row ndep */
+static int depRow(depCtx *dc, int i, glp_prob *P, glpkDepend *dp) {
+
+    int t, j, k, kk, len, nh = 0, err = 0;
+    double f, rhs, scale = 0, s2;
+
+    len = glp_get_mat_row(P, i, dc->rind, dc->rval);
+    rhs = glp_get_row_lb(P, i);
+
+    for (t = 1; t <= len; t++) {
+        j = dc->rind[t];
+        depWork(dc, j);
+        dc->w[j] = dc->rval[t];
+        if (fabs(dc->rval[t]) > scale) {
+            scale = fabs(dc->rval[t]);
+        }
+        k = dc->colpiv[j];
+        if ( (k >= 0) && (!dc->inheap[k]) ) {
+            dc->inheap[k] = 1;
+            heapPush(dc->heap, &nh, k);
+        }
+    }
+
+    while (nh > 0) {
+        k = heapPop(dc->heap, &nh);
+        dc->inheap[k] = 0;
+        f = dc->w[dc->pc[k]] / dc->pv[k];
+        dc->w[dc->pc[k]] = 0;
+        if (f == 0) {
+            continue;
+        }
+        for (t = dc->rbeg[k]; t < dc->rbeg[k+1]; t++) {
+            j = dc->R.ind[t];
+            depWork(dc, j);
+            dc->w[j] -= f * dc->R.val[t];
+            /* later pivots may lie in columns of row k */
+            kk = dc->colpiv[j];
+            if ( (kk > k) && (!dc->inheap[kk]) ) {
+                dc->inheap[kk] = 1;
+                heapPush(dc->heap, &nh, kk);
+            }
+        }
+        for (t = dc->cbeg[k]; t < dc->cbeg[k+1]; t++) {
+            depLam(dc, dc->C.ind[t], f * dc->C.val[t]);
+        }
+        rhs -= f * dc->rb[k];
+    }
+
+    j = depPivot(dc, dc->tol * scale);
+
+    if (j == 0) {
+        /* row i is the sum of lam times the rows in llist */
+        s2 = 1.0 + fabs(glp_get_row_lb(P, i));
+        k = dp->ndep++;
+        dp->dep[k]  = i;
+        dp->res[k]  = rhs;
+        dp->lbeg[k] = dc->L.len;
+        for (t = 0; (t < dc->nl) && (!err); t++) {
+            if (dc->lam[dc->llist[t]] != 0) {
+                s2 += fabs(dc->lam[dc->llist[t]] *
+                           glp_get_row_lb(P, dc->llist[t]));
+                err = poolPut(&dc->L, dc->llist[t], dc->lam[dc->llist[t]]);
+            }
+        }
+        dp->lbeg[k+1] = dc->L.len;
+        dp->cons[k]   = (fabs(rhs) <= dc->tol * s2);
+    }
+    else {
+        k = dp->rank++;
+        dc->pc[k] = j;
+        dc->pv[k] = dc->w[j];
+        dc->rb[k] = rhs;
+        dc->colpiv[j] = k;
+        for (t = 0; (t < dc->nw) && (!err); t++) {
+            kk = dc->wlist[t];
+            if ( (kk != j) && (fabs(dc->w[kk]) > dc->tol * scale) ) {
+                err = poolPut(&dc->R, kk, dc->w[kk]);
+            }
+        }
+        dc->rbeg[k+1] = dc->R.len;
+        err |= poolPut(&dc->C, i, 1.0);
+        for (t = 0; (t < dc->nl) && (!err); t++) {
+            if (dc->lam[dc->llist[t]] != 0) {
+                err = poolPut(&dc->C, dc->llist[t], -dc->lam[dc->llist[t]]);
+            }
+        }
+        dc->cbeg[k+1] = dc->C.len;
+    }
+
+    for (t = 0; t < dc->nw; t++) {
+        dc->wmark[dc->wlist[t]] = 0;
+    }
+    for (t = 0; t < dc->nl; t++) {
+        dc->lmark[dc->llist[t]] = 0;
+    }
+    dc->nw = 0;
+    dc->nl = 0;
+
+    return err;
+}
+
+static void depFree(depCtx *dc) {
+
+    free(dc->eq);
+    free(dc->colcnt);
+    free(dc->rind);
+    free(dc->rval);
+    free(dc->w);
+    free(dc->wmark);
+    free(dc->wlist);
+    free(dc->lam);
+    free(dc->lmark);
+    free(dc->llist);
+    free(dc->colpiv);
+    free(dc->pc);
+    free(dc->pv);
+    free(dc->rb);
+    free(dc->rbeg);
+    free(dc->cbeg);
+    free(dc->heap);
+    free(dc->inheap);
+    free(dc->R.ind);
+    free(dc->R.val);
+    free(dc->C.ind);
+    free(dc->C.val);
+}
+
+int glpkDependRows(glp_prob *P, double tol, glpkDepend *dp) {
+
+    depCtx dc;
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int *cnt;
+    int i, j, t, len, neq = 0, err = 0;
+
+    memset(&dc, 0, sizeof(dc));
+    memset(dp, 0, sizeof(glpkDepend));
+
+    dc.m   = m;
+    dc.n   = n;
+    dc.tol = tol;
+
+    dc.eq     = malloc(((size_t) m + 1) * sizeof(int));
+    dc.colcnt = calloc((size_t) n + 1, sizeof(int));
+    dc.rind   = malloc(((size_t) n + 1) * sizeof(int));
+    dc.rval   = malloc(((size_t) n + 1) * sizeof(double));
+    dc.w      = malloc(((size_t) n + 1) * sizeof(double));
+    dc.wmark  = calloc((size_t) n + 1, sizeof(int));
+    dc.wlist  = malloc(((size_t) n + 1) * sizeof(int));
+    dc.lam    = malloc(((size_t) m + 1) * sizeof(double));
+    dc.lmark  = calloc((size_t) m + 1, sizeof(int));
+    dc.llist  = malloc(((size_t) m + 1) * sizeof(int));
+    dc.colpiv = malloc(((size_t) n + 1) * sizeof(int));
+    dc.pc     = malloc(((size_t) m + 1) * sizeof(int));
+    dc.pv     = malloc(((size_t) m + 1) * sizeof(double));
+    dc.rb     = malloc(((size_t) m + 1) * sizeof(double));
+    dc.rbeg   = calloc((size_t) m + 2, sizeof(int));
+    dc.cbeg   = calloc((size_t) m + 2, sizeof(int));
+    dc.heap   = malloc(((size_t) m + 1) * sizeof(int));
+    dc.inheap = calloc((size_t) m + 1, sizeof(int));
+    cnt       = calloc((size_t) n + 2, sizeof(int));
+
+    dp->dep  = malloc(((size_t) m + 1) * sizeof(int));
+    dp->cons = malloc(((size_t) m + 1) * sizeof(int));
+    dp->res  = malloc(((size_t) m + 1) * sizeof(double));
+    dp->lbeg = calloc((size_t) m + 2, sizeof(int));
+
+    if ( (dc.eq == NULL) || (dc.colcnt == NULL) || (dc.rind == NULL) ||
+         (dc.rval == NULL) || (dc.w == NULL) || (dc.wmark == NULL) ||
+         (dc.wlist == NULL) || (dc.lam == NULL) || (dc.lmark == NULL) ||
+         (dc.llist == NULL) || (dc.colpiv == NULL) || (dc.pc == NULL) ||
+         (dc.pv == NULL) || (dc.rb == NULL) || (dc.rbeg == NULL) ||
+         (dc.cbeg == NULL) || (dc.heap == NULL) || (dc.inheap == NULL) ||
+         (cnt == NULL) || (dp->dep == NULL) || (dp->cons == NULL) ||
+         (dp->res == NULL) || (dp->lbeg == NULL) ) {
+        free(cnt);
+        depFree(&dc);
+        glpkDependFree(dp);
+        return 1;
+    }
+
+    for (j = 1; j <= n; j++) {
+        dc.colpiv[j] = -1;
+    }
+
+    /* equality rows by number of nonzeros (counting sort) */
+    for (i = 1; i <= m; i++) {
+        if (glp_get_row_type(P, i) == GLP_FX) {
+            len = glp_get_mat_row(P, i, dc.rind, NULL);
+            for (t = 1; t <= len; t++) {
+                dc.colcnt[dc.rind[t]]++;
+            }
+            cnt[len+1]++;
+            neq++;
+        }
+    }
+    for (j = 1; j <= n + 1; j++) {
+        cnt[j] += cnt[j-1];
+    }
+    for (i = 1; i <= m; i++) {
+        if (glp_get_row_type(P, i) == GLP_FX) {
+            dc.eq[cnt[glp_get_mat_row(P, i, NULL, NULL)]++] = i;
+        }
+    }
+    free(cnt);
+
+    dp->neq = neq;
+
+    for (t = 0; (t < neq) && (!err); t++) {
+        err = depRow(&dc, dc.eq[t], P, dp);
+    }
+
+    /* hand over the combinations */
+    dp->lind = dc.L.ind;
+    dp->lval = dc.L.val;
+    dc.L.ind = NULL;
+    dc.L.val = NULL;
+
+    depFree(&dc);
+
+    if (err) {
+        glpkDependFree(dp);
+    }
+
+    return err;
+}
+
+void glpkDependFree(glpkDepend *dp) {
+
+    free(dp->dep);
+    free(dp->cons);
+    free(dp->res);
+    free(dp->lbeg);
+    free(dp->lind);
+    free(dp->lval);
+
+    dp->dep  = NULL;
+    dp->cons = NULL;
+    dp->res  = NULL;
+    dp->lbeg = NULL;
+    dp->lind = NULL;
+    dp->lval = NULL;
+    dp->ndep = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* deletion                                                                   */
+/* -------------------------------------------------------------------------- */
+
+int glpkDependDelete(glp_prob *P, const glpkDepend *dp, int *rowmap,
+                     int *nrows) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int *num;
+    int i, j, k, nd, nbas;
+
+    num = calloc((size_t) m + 1, sizeof(int));
+    if (num == NULL) {
+        return 1;
+    }
+
+    /* mark first, the rows were found in another order */
+    for (k = 0; k < dp->ndep; k++) {
+        if (dp->cons[k]) {
+            num[dp->dep[k]] = 1;
+        }
+    }
+
+    /* compact in place, nd never passes i */
+    nd = 0;
+    *nrows = 0;
+    for (i = 1; i <= m; i++) {
+        if (num[i]) {
+            num[++nd] = i;
+        }
+        else {
+            rowmap[(*nrows)++] = i;
+        }
+    }
+    if (nd > 0) {
+        glp_del_rows(P, nd, num);
+    }
+
+    /* deleted rows may have been nonbasic */
+    nbas = 0;
+    for (i = 1; i <= *nrows; i++) {
+        nbas += (glp_get_row_stat(P, i) == GLP_BS);
+    }
+    for (j = 1; j <= n; j++) {
+        nbas += (glp_get_col_stat(P, j) == GLP_BS);
+    }
+    if (nbas != *nrows) {
+        glp_std_basis(P);
+    }
+
+    free(num);
+
+    return 0;
+}
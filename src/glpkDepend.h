@@ -0,0 +1,63 @@
+/* glpkDepend.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* linearly dependent equality rows                                           */
+/* -------------------------------------------------------------------------- */
+
+/* The equality rows (GLP_FX) are factorized one after the other, sparsest
+   first, by a row-wise sparse LU with threshold partial pivoting: a row is
+   reduced by the pivot rows found so far; if nothing remains (relative to
+   tol and the largest coefficient of the row), the row is a combination of
+   earlier rows, otherwise its largest remaining entries (within a factor of
+   ten, preferring sparse columns) give a new pivot. Pivot rows always stay
+   in the problem, so the combinations of dependent rows only refer to rows
+   which are kept. */
+
+typedef struct {
+    int neq;                 /* equality rows examined */
+    int rank;                /* their rank */
+    int ndep;                /* dependent rows */
+    int *dep;                /* their original indices, in the order found */
+    int *cons;               /* 1 if consistent with the right hand sides */
+    double *res;             /* residual of the right hand side */
+    int *lbeg;               /* dep[k] is the sum of lval[t] times row
+                                lind[t], t from lbeg[k] up to
+                                lbeg[k + 1] - 1 */
+    int *lind;
+    double *lval;
+} glpkDepend;
+
+/* Returns nonzero if out of memory. */
+int glpkDependRows(glp_prob *P, double tol, glpkDepend *dp);
+
+void glpkDependFree(glpkDepend *dp);
+
+/* Delete the consistent dependent rows. rowmap (m elements) receives the
+   original indices of the remaining rows, *nrows their number. If the basis
+   of P lost basic variables, it is replaced by the standard basis. Returns
+   nonzero if out of memory. */
+int glpkDependDelete(glp_prob *P, const glpkDepend *dp, int *rowmap,
+                     int *nrows);
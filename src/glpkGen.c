@@ -0,0 +1,196 @@
+/* glpkGen.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "glpkSnapshot.h"
+#include "glpkGen.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* random numbers                                                             */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    uint64_t s[4];
+} genRng;
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* the state is filled by splitmix64 */
+static void rngSeed(genRng *rng, uint64_t seed) {
+
+    uint64_t z;
+    int k;
+
+    for (k = 0; k < 4; k++) {
+        seed += 0x9E3779B97F4A7C15ULL;
+        z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[k] = z ^ (z >> 31);
+    }
+}
+
+static uint64_t rngNext(genRng *rng) {
+
+    uint64_t *s = rng->s;
+    uint64_t res = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return res;
+}
+
+/* uniform in [0, 1) */
+static double rngUnif(genRng *rng) {
+    return (double) (rngNext(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* uniform in 0 .. k - 1 */
+static int rngInt(genRng *rng, int k) {
+    return (int) (rngUnif(rng) * k);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* generator                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* rows of column j, ind and val are 1-based */
+static int genCol(const glpkGenParm *gp, genRng *rng, int *ind,
+                  double *val) {
+
+    int len = (int) gp->nnzcol;
+    int nsub, k, l, r;
+
+    if (rngUnif(rng) < gp->nnzcol - len) {
+        len++;
+    }
+    if (len < 1) {
+        len = 1;
+    }
+    if (len > gp->m) {
+        len = gp->m;
+    }
+    nsub = (len + 1) / 2;
+
+    for (k = 1; k <= len; k++) {
+        /* columns are short, a linear search for duplicates is fastest */
+        do {
+            r = 1 + rngInt(rng, gp->m);
+            for (l = 1; (l < k) && (ind[l] != r); l++) {
+                ;
+            }
+        } while (l < k);
+        ind[k] = r;
+        val[k] = gp->cmin + rngUnif(rng) * (gp->cmax - gp->cmin);
+        if (k <= nsub) {
+            val[k] = -val[k];
+        }
+    }
+
+    return len;
+}
+
+int glpkGenModel(const glpkGenParm *gp, glp_prob *P, const char *fname,
+                 double *nnz) {
+
+    glpkSnapFile sf;
+    genRng rng;
+    int *ind;
+    double *val;
+    double lb, coef;
+    int i, j, len, kind;
+
+    *nnz = 0;
+
+    ind = malloc(((size_t) gp->m + 1) * sizeof(int));
+    val = malloc(((size_t) gp->m + 1) * sizeof(double));
+    if ( (ind == NULL) || (val == NULL) ) {
+        free(ind);
+        free(val);
+        return 1;
+    }
+
+    if (P != NULL) {
+        glp_erase_prob(P);
+        glp_set_obj_dir(P, GLP_MAX);
+        glp_add_rows(P, gp->m);
+        glp_add_cols(P, gp->n);
+        for (i = 1; i <= gp->m; i++) {
+            glp_set_row_bnds(P, i, GLP_FX, 0.0, 0.0);
+        }
+    }
+    else {
+        if (glpkSnapFileOpen(&sf, fname, gp->m, gp->n, GLP_MAX) != 0) {
+            if (sf.fh != NULL) {
+                fclose(sf.fh);
+            }
+            free(ind);
+            free(val);
+            return 1;
+        }
+        for (i = 1; i <= gp->m; i++) {
+            glpkSnapFileRow(&sf, GLP_FX, 0.0, 0.0);
+        }
+    }
+
+    rngSeed(&rng, (uint64_t) gp->seed);
+
+    for (j = 1; j <= gp->n; j++) {
+        len  = genCol(gp, &rng, ind, val);
+        lb   = (rngUnif(&rng) < gp->rev) ? -gp->bound : 0.0;
+        kind = (rngUnif(&rng) < gp->intfrac) ? GLP_IV : GLP_CV;
+        coef = (j == gp->n) ? 1.0 : 0.0;
+        if (P != NULL) {
+            glp_set_col_kind(P, j, kind);
+            glp_set_col_bnds(P, j, GLP_DB, lb, gp->bound);
+            glp_set_obj_coef(P, j, coef);
+            glp_set_mat_col(P, j, len, ind, val);
+        }
+        else {
+            glpkSnapFileCol(&sf, GLP_DB, kind, lb, gp->bound, coef, len,
+                            ind, val);
+        }
+        *nnz += len;
+    }
+
+    free(ind);
+    free(val);
+
+    if (P == NULL) {
+        return glpkSnapFileClose(&sf);
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/* glpkGen.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* synthetic stoichiometry-like models                                        */
+/* -------------------------------------------------------------------------- */
+
+/* The generated problem has m rows (metabolites, fixed to zero) and n
+   columns (reactions). Every column has on average nnzcol nonzeros in
+   distinct rows; the first half of them (substrates) is negative, the
+   others (products) are positive, their absolute values are uniformly
+   distributed in [cmin, cmax]. A fraction rev of the columns has bounds
+   [-bound, bound], the other columns [0, bound]; a fraction intfrac is of
+   integer kind. The last column is maximized. The random numbers come from
+   a generator of the package (xoshiro256**), so a seed gives the same
+   problem on every platform. The routines never call into R. */
+
+typedef struct {
+    int m;
+    int n;
+    double nnzcol;
+    double rev;
+    double cmin;
+    double cmax;
+    double intfrac;
+    double bound;
+    double seed;
+} glpkGenParm;
+
+/* generate into the problem object P (erased before) or, if P is NULL, into
+   the snapshot file fname; *nnz is the number of nonzeros generated.
+   Returns zero on success. */
+int glpkGenModel(const glpkGenParm *gp, glp_prob *P, const char *fname,
+                 double *nnz);
@@ -0,0 +1,264 @@
+/* glpkLog.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "glpkR.h"
+#include "glpkProf.h"
+#include "glpkLog.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* log buffer                                                                 */
+/* -------------------------------------------------------------------------- */
+
+glpkLog *glpkLogAlloc(int cap) {
+
+    glpkLog *log;
+
+    if (cap < 1) {
+        cap = 1;
+    }
+
+    log = (glpkLog *) calloc(1, sizeof(glpkLog));
+    if (log == NULL) {
+        return NULL;
+    }
+    log->ent = (glpkLogEntry *) malloc((size_t) cap * sizeof(glpkLogEntry));
+    if (log->ent == NULL) {
+        free(log);
+        return NULL;
+    }
+    log->cap = cap;
+    log->interval = 1.0;
+
+    return log;
+}
+
+void glpkLogFree(glpkLog *log) {
+    if (log != NULL) {
+        free(log->ent);
+        free(log);
+    }
+}
+
+void glpkLogClear(glpkLog *log) {
+    log->first   = 0;
+    log->n       = 0;
+    log->dropped = 0;
+    log->lines   = 0;
+    log->solve   = 0;
+}
+
+void glpkLogBegin(glpkLog *log) {
+    log->solve++;
+    log->t0     = glpkProfTime();
+    log->tprint = -1;
+    log->len    = 0;
+}
+
+const glpkLogEntry *glpkLogEntryAt(const glpkLog *log, int k) {
+    return &log->ent[(log->first + k) % log->cap];
+}
+
+static glpkLogEntry *logNext(glpkLog *log) {
+
+    glpkLogEntry *ent;
+
+    if (log->n < log->cap) {
+        ent = &log->ent[(log->first + log->n) % log->cap];
+        log->n++;
+    }
+    else {
+        /* full: overwrite the oldest entry */
+        ent = &log->ent[log->first];
+        log->first = (log->first + 1) % log->cap;
+        log->dropped++;
+    }
+
+    return ent;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* parser                                                                     */
+/* -------------------------------------------------------------------------- */
+
+/* number following "key", NaN if the key is missing or not followed by a
+   number */
+static double numAfter(const char *line, const char *key) {
+
+    const char *p = strstr(line, key);
+    char *end;
+    double val;
+
+    if (p == NULL) {
+        return R_NaN;
+    }
+    p += strlen(key);
+    val = strtod(p, &end);
+
+    return (end == p) ? R_NaN : val;
+}
+
+/* progress lines start with an optional marker and "<iteration>:", e.g.
+     simplex   "*   123: obj =  1.0e+01 inf =  0.0e+00 (0)"
+               "    123: objval =  1.0e+01 infeas =  0.0e+00" (exact, old)
+     interior  "  12: obj =  1.0e+01; rpi =  1.0e-03; rdi =  1.0e-03; gap =
+                1.0e-02"
+     MIP       "+   123: mip =  1.0e+01 >=  2.0e+01  50.0% (5; 2)"
+               "+   123: >>>>>  1.0e+01 >=  2.0e+01  50.0% (5; 2)"
+   returns zero if the line is a progress line */
+static int parseLine(const char *line, glpkLogEntry *ent) {
+
+    const char *p = line;
+    const char *q;
+    const char *key;
+    char *end;
+    double rpi, rdi;
+    int phase2 = 0;
+
+    while (*p == ' ') {
+        p++;
+    }
+    if ( (*p == '*') || (*p == '+') ) {
+        phase2 = 1;
+        p++;
+    }
+    ent->iter = strtod(p, &end);
+    if ( (end == p) || (*end != ':') ) {
+        return 1;
+    }
+    p = end + 1;
+
+    ent->phase2 = phase2;
+    ent->obj    = R_NaN;
+    ent->infeas = R_NaN;
+    ent->bound  = R_NaN;
+    ent->gap    = R_NaN;
+    ent->active = NA_INTEGER;
+    ent->done   = NA_INTEGER;
+
+    if ( (strstr(p, "mip =") != NULL) || (strstr(p, ">>>>>") != NULL) ) {
+        /* ">>>>>" marks a new incumbent */
+        key = (strstr(p, ">>>>>") != NULL) ? ">>>>>" : "mip =";
+        ent->kind = GLPK_LOG_MIP;
+        ent->obj  = numAfter(p, key);
+        ent->bound = numAfter(p, ">=");
+        if (ISNAN(ent->bound)) {
+            ent->bound = numAfter(p, "<=");
+        }
+        q = strchr(p, '%');
+        if (q != NULL) {
+            /* the gap is the number in front of '%' */
+            while ( (q > p) && (q[-1] != ' ') ) {
+                q--;
+            }
+            ent->gap = strtod(q, NULL);
+        }
+        q = strchr(p, '(');
+        if (q != NULL) {
+            sscanf(q, "(%d; %d)", &ent->active, &ent->done);
+        }
+    }
+    else if (strstr(p, "rpi =") != NULL) {
+        ent->kind = GLPK_LOG_INTERIOR;
+        ent->obj  = numAfter(p, "obj =");
+        rpi = numAfter(p, "rpi =");
+        rdi = numAfter(p, "rdi =");
+        ent->infeas = (rpi > rdi) ? rpi : rdi;
+        ent->gap = 100 * numAfter(p, "gap =");
+    }
+    else if (strstr(p, "obj") != NULL) {
+        ent->kind = GLPK_LOG_SIMPLEX;
+        key = (strstr(p, "objval =") != NULL) ? "objval =" : "obj =";
+        ent->obj = numAfter(p, key);
+        key = (strstr(p, "infeas =") != NULL) ? "infeas =" : "inf =";
+        ent->infeas = numAfter(p, key);
+    }
+    else {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* terminal hook                                                              */
+/* -------------------------------------------------------------------------- */
+
+static void logLine(glpkLog *log) {
+
+    glpkLogEntry ent;
+    double now = glpkProfTime() - log->t0;
+    int print;
+
+    log->line[log->len] = '\0';
+    log->lines++;
+
+    if (parseLine(log->line, &ent) == 0) {
+        ent.solve = log->solve;
+        ent.time  = now;
+        *logNext(log) = ent;
+        /* progress lines are rate limited, messages are always printed */
+        print = log->pass &&
+                ( (log->tprint < 0) || (now - log->tprint >= log->interval) );
+        if (print) {
+            log->tprint = now;
+        }
+    }
+    else {
+        print = log->pass;
+    }
+
+    if (print) {
+        Rprintf("%s\n", log->line);
+    }
+
+    log->len = 0;
+}
+
+int glpkLogHook(void *info, const char *s) {
+
+    glpkLog *log = (glpkLog *) info;
+
+    for (; *s != '\0'; s++) {
+        if (*s == '\n') {
+            logLine(log);
+        }
+        else if (log->len < GLPK_LOG_LINE - 1) {
+            log->line[log->len++] = *s;
+        }
+    }
+
+    /* nonzero: GLPK does not print the text itself */
+    return 1;
+}
+
+void glpkLogEnd(glpkLog *log) {
+    if (log->len > 0) {
+        logLine(log);
+    }
+}
@@ -0,0 +1,91 @@
+/* glpkLog.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* structured capture of the solver log                                       */
+/* -------------------------------------------------------------------------- */
+
+/* During a solve, glpkLogHook is installed as terminal hook. It collects
+   the output of GLPK into lines and parses the progress lines of the
+   simplex, interior point and branch-and-cut solvers into entries of a ring
+   buffer of fixed size. Other lines are only counted. */
+
+/* kind of a progress line */
+#define GLPK_LOG_SIMPLEX  0
+#define GLPK_LOG_INTERIOR 1
+#define GLPK_LOG_MIP      2
+
+#define GLPK_LOG_LINE 256
+
+typedef struct {
+    int solve;         /* number of the solve (per problem) */
+    int kind;          /* GLPK_LOG_SIMPLEX, ... */
+    double time;       /* seconds since start of the solve */
+    double iter;       /* iteration count */
+    double obj;        /* objective (incumbent for MIP, NaN if none) */
+    double infeas;     /* infeasibility (max(rpi, rdi) for interior) */
+    double bound;      /* best bound (MIP) */
+    double gap;        /* relative gap in % (MIP, interior) */
+    int active;        /* active nodes (MIP) */
+    int done;          /* completed nodes (MIP) */
+    int phase2;        /* marked with '*' (simplex) or '+' (MIP) */
+} glpkLogEntry;
+
+typedef struct {
+    glpkLogEntry *ent; /* ring buffer */
+    int cap;
+    int first;         /* oldest entry */
+    int n;             /* entries in buffer */
+    double dropped;    /* entries overwritten */
+    double lines;      /* all lines seen */
+    int solve;         /* current solve */
+    double t0;         /* start of the current solve */
+    int pass;          /* print lines to the console */
+    double interval;   /* minimum time between printed progress lines */
+    double tprint;     /* time of the last printed progress line */
+    char line[GLPK_LOG_LINE];
+    int len;
+} glpkLog;
+
+/* allocate a log with cap entries, NULL on failure */
+glpkLog *glpkLogAlloc(int cap);
+
+/* release a log */
+void glpkLogFree(glpkLog *log);
+
+/* remove all entries */
+void glpkLogClear(glpkLog *log);
+
+/* start a new solve */
+void glpkLogBegin(glpkLog *log);
+
+/* flush an incomplete last line */
+void glpkLogEnd(glpkLog *log);
+
+/* terminal hook, info is a glpkLog */
+int glpkLogHook(void *info, const char *s);
+
+/* k-th entry, counted from the oldest one */
+const glpkLogEntry *glpkLogEntryAt(const glpkLog *log, int k);
@@ -0,0 +1,471 @@
+/* glpkLoop.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkLoop.h"
+
+/* entries below are dropped during elimination */
+#define LOOP_DROP_TOL 1e-10
+
+/* a pivot must have at least this fraction of the largest entry of its
+   row; among those, the column with fewest nonzeros is chosen */
+#define LOOP_PIV_TOL 0.1
+
+
+/* -------------------------------------------------------------------------- */
+/* sparse rows                                                                */
+/* -------------------------------------------------------------------------- */
+
+/* row of the echelon form without its pivot (which is one), entries sorted
+   by position */
+typedef struct {
+    int piv;
+    int len;
+    int *pos;
+    double *val;
+} loopRow;
+
+static double rowGet(const loopRow *r, int c) {
+
+    int lo = 0, hi = r->len - 1, mid;
+
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (r->pos[mid] == c) {
+            return r->val[mid];
+        }
+        if (r->pos[mid] < c) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+
+    return 0;
+}
+
+/* q = q - alpha * r, entry c of q is removed; returns nonzero if out of
+   memory */
+static int rowElim(loopRow *q, double alpha, const loopRow *r, int c) {
+
+    int *pos;
+    double *val, v;
+    int s = 0, t = 0, len = 0;
+
+    pos = malloc(((size_t) q->len + r->len + 1) * sizeof(int));
+    val = malloc(((size_t) q->len + r->len + 1) * sizeof(double));
+    if ( (pos == NULL) || (val == NULL) ) {
+        free(pos);
+        free(val);
+        return 1;
+    }
+
+    while ( (s < q->len) || (t < r->len) ) {
+        if ( (t >= r->len) || ( (s < q->len) && (q->pos[s] < r->pos[t]) ) ) {
+            pos[len] = q->pos[s];
+            v = q->val[s++];
+        }
+        else if ( (s >= q->len) || (r->pos[t] < q->pos[s]) ) {
+            pos[len] = r->pos[t];
+            v = -alpha * r->val[t++];
+        }
+        else {
+            pos[len] = q->pos[s];
+            v = q->val[s++] - alpha * r->val[t++];
+        }
+        if ( (pos[len] != c) && (fabs(v) > LOOP_DROP_TOL) ) {
+            val[len++] = v;
+        }
+    }
+
+    free(q->pos);
+    free(q->val);
+    q->pos = pos;
+    q->val = val;
+    q->len = len;
+
+    return 0;
+}
+
+static void rowsFree(loopRow *rows, int nrows) {
+
+    int k;
+
+    for (k = 0; k < nrows; k++) {
+        free(rows[k].pos);
+        free(rows[k].val);
+    }
+    free(rows);
+}
+
+static int cmpInt(const void *a, const void *b) {
+
+    int x = *(const int *) a, y = *(const int *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* null space                                                                 */
+/* -------------------------------------------------------------------------- */
+
+void glpkNullSpaceFree(glpkNullSpace *ns) {
+
+    free(ns->p);
+    free(ns->pos);
+    free(ns->val);
+    ns->p    = NULL;
+    ns->pos  = NULL;
+    ns->val  = NULL;
+    ns->nvec = 0;
+}
+
+/* reduced row echelon form of the internal columns, one row at a time */
+static int echelon(glp_prob *P, int nc, const int *ind, loopRow *rows,
+                   int *nrows, int *pivOf) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int *rind, *pmap, *cnt, *nz, *mark;
+    double *rval, *w;
+    loopRow *q, *r;
+    int i, j, k, t, u, c, len, nnz, nz0, best, err = 0;
+    double alpha, vmax;
+
+    rind = malloc(((size_t) n + 1) * sizeof(int));
+    rval = malloc(((size_t) n + 1) * sizeof(double));
+    pmap = malloc(((size_t) n + 1) * sizeof(int));
+    cnt  = calloc((size_t) nc + 1, sizeof(int));
+    nz   = malloc(((size_t) nc + 1) * sizeof(int));
+    mark = calloc((size_t) nc + 1, sizeof(int));
+    w    = calloc((size_t) nc + 1, sizeof(double));
+
+    if ( (rind == NULL) || (rval == NULL) || (pmap == NULL) ||
+         (cnt == NULL) || (nz == NULL) || (mark == NULL) || (w == NULL) ) {
+        err = 1;
+        goto done;
+    }
+
+    for (j = 1; j <= n; j++) {
+        pmap[j] = -1;
+    }
+    for (k = 0; k < nc; k++) {
+        pmap[ind[k]] = k;
+        pivOf[k] = -1;
+        len = glp_get_mat_col(P, ind[k], rind, rval);
+        cnt[k] = len;
+    }
+
+    *nrows = 0;
+
+    for (i = 1; (i <= m) && (!err); i++) {
+        len = glp_get_mat_row(P, i, rind, rval);
+        nnz = 0;
+        for (t = 1; t <= len; t++) {
+            c = pmap[rind[t]];
+            if (c < 0) {
+                continue;
+            }
+            if (!mark[c]) {
+                mark[c] = 1;
+                nz[nnz++] = c;
+            }
+            w[c] += rval[t];
+        }
+        if (nnz == 0) {
+            continue;
+        }
+
+        /* eliminate the current pivots; pivot rows contain no other pivot
+           columns, so fill-in is in free columns only */
+        nz0 = nnz;
+        for (t = 0; t < nz0; t++) {
+            c = nz[t];
+            if ( (pivOf[c] < 0) || (w[c] == 0) ) {
+                continue;
+            }
+            q = &rows[pivOf[c]];
+            alpha = w[c];
+            for (u = 0; u < q->len; u++) {
+                if (!mark[q->pos[u]]) {
+                    mark[q->pos[u]] = 1;
+                    nz[nnz++] = q->pos[u];
+                }
+                w[q->pos[u]] -= alpha * q->val[u];
+            }
+            w[c] = 0;
+        }
+
+        vmax = 0;
+        for (t = 0; t < nnz; t++) {
+            if ( (pivOf[nz[t]] < 0) && (fabs(w[nz[t]]) > vmax) ) {
+                vmax = fabs(w[nz[t]]);
+            }
+        }
+
+        best = -1;
+        if (vmax > LOOP_DROP_TOL) {
+            for (t = 0; t < nnz; t++) {
+                c = nz[t];
+                if ( (pivOf[c] < 0) && (fabs(w[c]) >= LOOP_PIV_TOL * vmax) &&
+                     ( (best < 0) || (cnt[c] < cnt[best]) ) ) {
+                    best = c;
+                }
+            }
+        }
+
+        if (best >= 0) {
+            /* new row of the echelon form, normalized to pivot one */
+            qsort(nz, (size_t) nnz, sizeof(int), cmpInt);
+            r = &rows[*nrows];
+            r->piv = best;
+            r->len = 0;
+            r->pos = malloc(((size_t) nnz + 1) * sizeof(int));
+            r->val = malloc(((size_t) nnz + 1) * sizeof(double));
+            if ( (r->pos == NULL) || (r->val == NULL) ) {
+                free(r->pos);
+                free(r->val);
+                err = 1;
+            }
+            else {
+                alpha = w[best];
+                for (t = 0; t < nnz; t++) {
+                    c = nz[t];
+                    if ( (c != best) && (pivOf[c] < 0) &&
+                         (fabs(w[c] / alpha) > LOOP_DROP_TOL) ) {
+                        r->pos[r->len] = c;
+                        r->val[r->len++] = w[c] / alpha;
+                    }
+                }
+                (*nrows)++;
+
+                /* keep the form reduced: remove the new pivot column from
+                   the other rows */
+                for (k = 0; (k < *nrows - 1) && (!err); k++) {
+                    alpha = rowGet(&rows[k], best);
+                    if (alpha != 0) {
+                        err = rowElim(&rows[k], alpha, r, best);
+                    }
+                }
+                pivOf[best] = *nrows - 1;
+            }
+        }
+
+        for (t = 0; t < nnz; t++) {
+            mark[nz[t]] = 0;
+            w[nz[t]] = 0;
+        }
+    }
+
+    done:
+    free(rind);
+    free(rval);
+    free(pmap);
+    free(cnt);
+    free(nz);
+    free(mark);
+    free(w);
+
+    return err;
+}
+
+int glpkNullSpaceCompute(glp_prob *P, int nc, const int *ind,
+                         glpkNullSpace *ns) {
+
+    loopRow *rows;
+    int *pivOf, *vec;
+    int k, t, u, f, nrows = 0, nnz;
+    int m = glp_get_num_rows(P);
+    int maxrows = (m < nc) ? m : nc;
+
+    ns->nvec = 0;
+    ns->rank = 0;
+    ns->p    = NULL;
+    ns->pos  = NULL;
+    ns->val  = NULL;
+
+    rows  = calloc((size_t) maxrows + 1, sizeof(loopRow));
+    pivOf = malloc(((size_t) nc + 1) * sizeof(int));
+    vec   = malloc(((size_t) nc + 1) * sizeof(int));
+    if ( (rows == NULL) || (pivOf == NULL) || (vec == NULL) ) {
+        free(rows);
+        free(pivOf);
+        free(vec);
+        return 1;
+    }
+
+    if (echelon(P, nc, ind, rows, &nrows, pivOf) != 0) {
+        rowsFree(rows, nrows);
+        free(pivOf);
+        free(vec);
+        return 1;
+    }
+
+    /* vector number of every free column */
+    nnz = 0;
+    for (k = 0; k < nc; k++) {
+        vec[k] = -1;
+        if (pivOf[k] < 0) {
+            vec[k] = ns->nvec++;
+            nnz++;
+        }
+    }
+    for (k = 0; k < nrows; k++) {
+        nnz += rows[k].len;
+    }
+
+    ns->rank = nrows;
+    ns->p    = calloc((size_t) ns->nvec + 2, sizeof(int));
+    ns->pos  = malloc(((size_t) nnz + 1) * sizeof(int));
+    ns->val  = malloc(((size_t) nnz + 1) * sizeof(double));
+    if ( (ns->p == NULL) || (ns->pos == NULL) || (ns->val == NULL) ) {
+        glpkNullSpaceFree(ns);
+        rowsFree(rows, nrows);
+        free(pivOf);
+        free(vec);
+        return 1;
+    }
+
+    /* vector of the free column f: one at f, minus the entries of column f
+       of the echelon form at the pivots */
+    for (k = 0; k < nc; k++) {
+        if (vec[k] >= 0) {
+            ns->p[vec[k] + 2]++;
+        }
+    }
+    for (k = 0; k < nrows; k++) {
+        for (t = 0; t < rows[k].len; t++) {
+            ns->p[vec[rows[k].pos[t]] + 2]++;
+        }
+    }
+    for (f = 2; f <= ns->nvec; f++) {
+        ns->p[f] += ns->p[f-1];
+    }
+    for (k = 0; k < nc; k++) {
+        if (vec[k] >= 0) {
+            u = ns->p[vec[k] + 1]++;
+            ns->pos[u] = k;
+            ns->val[u] = 1;
+        }
+    }
+    for (k = 0; k < nrows; k++) {
+        for (t = 0; t < rows[k].len; t++) {
+            u = ns->p[vec[rows[k].pos[t]] + 1]++;
+            ns->pos[u] = rows[k].piv;
+            ns->val[u] = -rows[k].val[t];
+        }
+    }
+
+    rowsFree(rows, nrows);
+    free(pivOf);
+    free(vec);
+
+    return 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* loopless constraints                                                       */
+/* -------------------------------------------------------------------------- */
+
+int glpkLoopless(glp_prob *P, int nc, const int *ind, double bigM,
+                 double eps, glpkLoopStat *st) {
+
+    glpkNullSpace ns;
+    int *ja;
+    double *ar;
+    int k, t, len, a, g, i;
+
+    st->col0  = glp_get_num_cols(P);
+    st->row0  = glp_get_num_rows(P);
+    st->nnull = 0;
+    st->rank  = 0;
+
+    if (glpkNullSpaceCompute(P, nc, ind, &ns) != 0) {
+        return 1;
+    }
+
+    ja = malloc(((size_t) nc + 1) * sizeof(int));
+    ar = malloc(((size_t) nc + 1) * sizeof(double));
+    if ( (ja == NULL) || (ar == NULL) ) {
+        free(ja);
+        free(ar);
+        glpkNullSpaceFree(&ns);
+        return 1;
+    }
+
+    st->nnull = ns.nvec;
+    st->rank  = ns.rank;
+
+    if (nc > 0) {
+        glp_add_cols(P, 2 * nc);
+        glp_add_rows(P, 2 * nc + ns.nvec);
+    }
+    else if (ns.nvec > 0) {
+        glp_add_rows(P, ns.nvec);
+    }
+
+    for (k = 0; k < nc; k++) {
+        a = st->col0 + 1 + k;
+        g = st->col0 + 1 + nc + k;
+        glp_set_col_kind(P, a, GLP_BV);
+        glp_set_col_bnds(P, g, GLP_DB, -bigM, bigM);
+
+        /* the flux has the sign of the indicator */
+        i = st->row0 + 1 + 2 * k;
+        ja[1] = ind[k]; ar[1] = 1;
+        ja[2] = a;      ar[2] = -bigM;
+        glp_set_mat_row(P, i, 2, ja, ar);
+        glp_set_row_bnds(P, i, GLP_DB, -bigM, 0);
+
+        /* the energy has the opposite sign */
+        ja[1] = g;      ar[1] = 1;
+        ja[2] = a;      ar[2] = bigM + eps;
+        glp_set_mat_row(P, i + 1, 2, ja, ar);
+        glp_set_row_bnds(P, i + 1, GLP_DB, eps, bigM);
+    }
+
+    for (k = 0; k < ns.nvec; k++) {
+        len = 0;
+        for (t = ns.p[k]; t < ns.p[k+1]; t++) {
+            len++;
+            ja[len] = st->col0 + 1 + nc + ns.pos[t];
+            ar[len] = ns.val[t];
+        }
+        i = st->row0 + 1 + 2 * nc + k;
+        glp_set_mat_row(P, i, len, ja, ar);
+        glp_set_row_bnds(P, i, GLP_FX, 0, 0);
+    }
+
+    free(ja);
+    free(ar);
+    glpkNullSpaceFree(&ns);
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/* glpkLoop.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* loopless flux balance analysis                                             */
+/* -------------------------------------------------------------------------- */
+
+/* Sparse right null space of the columns ind[k] (1-based, nc elements) of
+   the constraint matrix of P: columns p[t] .. p[t+1] - 1 of the basis have
+   the nonzeros val at the positions pos (0-based positions in ind). The
+   basis comes from the reduced row echelon form, computed by sparse
+   Gaussian elimination: every free column f gives one vector with
+   x_f = 1. */
+typedef struct {
+    int nvec;                /* dimension of the null space */
+    int rank;
+    int *p;                  /* nvec + 1 column pointers */
+    int *pos;
+    double *val;
+} glpkNullSpace;
+
+/* returns nonzero if out of memory */
+int glpkNullSpaceCompute(glp_prob *P, int nc, const int *ind,
+                         glpkNullSpace *ns);
+void glpkNullSpaceFree(glpkNullSpace *ns);
+
+/* Append the loopless constraints for the internal reactions ind[k] to P
+   (Schellenberger et al. 2011): for every reaction x_j a binary indicator
+   a and an energy column g in [-bigM, bigM] with the rows
+       -bigM  <= x_j - bigM a  <= 0
+       eps    <= g + (bigM + eps) a <= bigM
+   and one row N^T g = 0 per vector of the null space N. Indicators are
+   columns col0 + 1 .. col0 + nc, energies col0 + nc + 1 .. col0 + 2 nc,
+   the added rows start after row0. Returns nonzero if out of memory, P
+   is unchanged then. */
+typedef struct {
+    int col0;
+    int row0;
+    int nnull;
+    int rank;
+} glpkLoopStat;
+
+int glpkLoopless(glp_prob *P, int nc, const int *ind, double bigM,
+                 double eps, glpkLoopStat *st);
@@ -0,0 +1,243 @@
+/* glpkMem.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <limits.h>
+#include <setjmp.h>
+#include "glpkR.h"
+#include "glpkMem.h"
+
+
+int glpkMemLimit = 0;
+
+
+/* -------------------------------------------------------------------------- */
+/* memory usage                                                               */
+/* -------------------------------------------------------------------------- */
+
+void glpkMemUsage(double *count, double *cpeak, double *total, double *tpeak) {
+
+    int cnt, cpk;
+
+#if (GLP_MAJOR_VERSION == 4) && (GLP_MINOR_VERSION < 49)
+    /* older versions count bytes in a pair of 32 bit integers */
+    glp_long tot, tpk;
+
+    glp_mem_usage(&cnt, &cpk, &tot, &tpk);
+
+    *total = 4294967296.0 * tot.hi + (unsigned int) tot.lo;
+    *tpeak = 4294967296.0 * tpk.hi + (unsigned int) tpk.lo;
+#else
+    size_t tot, tpk;
+
+    glp_mem_usage(&cnt, &cpk, &tot, &tpk);
+
+    *total = (double) tot;
+    *tpeak = (double) tpk;
+#endif
+
+    *count = cnt;
+    *cpeak = cpk;
+}
+
+double glpkMemTotal(void) {
+
+    double count, cpeak, total, tpeak;
+
+    glpkMemUsage(&count, &cpeak, &total, &tpeak);
+
+    return total;
+}
+
+void glpkMemSetLimit(int mb) {
+
+    if (mb > 0) {
+        glp_mem_limit(mb);
+        glpkMemLimit = mb;
+    }
+    else {
+        glp_mem_limit(INT_MAX);
+        glpkMemLimit = 0;
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* garbage collection pressure                                                */
+/* -------------------------------------------------------------------------- */
+
+double glpkGcTrigger = 64.0 * 1048576.0;
+
+/* bytes held by all problem objects, and after the last collection */
+static double gcHeld = 0;
+static double gcLast = 0;
+
+void glpkGcAccount(double *held, double mem0) {
+
+    double delta = glpkMemTotal() - mem0;
+    double grow;
+
+    if (*held + delta < 0) {
+        delta = -(*held);
+    }
+    *held  += delta;
+    gcHeld += delta;
+
+    if (gcHeld < gcLast) {
+        gcLast = gcHeld;
+    }
+
+    grow = (gcLast > glpkGcTrigger) ? gcLast : glpkGcTrigger;
+    if ( (delta > 0) && (glpkGcTrigger > 0) && (gcHeld - gcLast > grow) ) {
+        /* finalizers of unreferenced problem objects call glpkGcRelease */
+        R_gc();
+        gcLast = gcHeld;
+    }
+}
+
+void glpkGcRelease(double *held) {
+
+    gcHeld -= *held;
+    *held   = 0;
+
+    if (gcHeld < gcLast) {
+        gcLast = gcHeld;
+    }
+}
+
+double glpkGcHeld(void) {
+    return gcHeld;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* guarded calls                                                              */
+/* -------------------------------------------------------------------------- */
+
+typedef struct guard {
+    jmp_buf env;
+    DL_FUNC fn;
+    int nargs;
+    SEXP *args;
+    int failed;
+    struct guard *prev;
+} glpkGuard;
+
+/* innermost active guard */
+static glpkGuard *guardTop = NULL;
+
+static void guardError(void *info) {
+    longjmp(((glpkGuard *) info)->env, 1);
+}
+
+void glpkGuardHook(void) {
+
+    if (guardTop != NULL) {
+        glp_error_hook(guardError, guardTop);
+    }
+    else {
+        glp_error_hook(NULL, NULL);
+    }
+}
+
+typedef SEXP (*fn0)(void);
+typedef SEXP (*fn1)(SEXP);
+typedef SEXP (*fn2)(SEXP, SEXP);
+typedef SEXP (*fn3)(SEXP, SEXP, SEXP);
+typedef SEXP (*fn4)(SEXP, SEXP, SEXP, SEXP);
+typedef SEXP (*fn5)(SEXP, SEXP, SEXP, SEXP, SEXP);
+typedef SEXP (*fn6)(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+typedef SEXP (*fn7)(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+
+static SEXP guardInvoke(DL_FUNC fn, int nargs, SEXP *a) {
+
+    switch (nargs) {
+        case 0:
+            return ((fn0) fn)();
+        case 1:
+            return ((fn1) fn)(a[0]);
+        case 2:
+            return ((fn2) fn)(a[0], a[1]);
+        case 3:
+            return ((fn3) fn)(a[0], a[1], a[2]);
+        case 4:
+            return ((fn4) fn)(a[0], a[1], a[2], a[3]);
+        case 5:
+            return ((fn5) fn)(a[0], a[1], a[2], a[3], a[4]);
+        case 6:
+            return ((fn6) fn)(a[0], a[1], a[2], a[3], a[4], a[5]);
+        default:
+            return ((fn7) fn)(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+    }
+}
+
+/* The jump target lies inside R_ExecWithCleanup, so no R context is left
+   by the longjmp. An R error raised by the entry point itself unwinds
+   through R_ExecWithCleanup, which removes the guard. */
+static SEXP guardRun(void *data) {
+
+    glpkGuard *g = data;
+
+    if (setjmp(g->env)) {
+        g->failed = 1;
+        return R_NilValue;
+    }
+
+    glp_error_hook(guardError, g);
+
+    return guardInvoke(g->fn, g->nargs, g->args);
+}
+
+static void guardEnd(void *data) {
+
+    glpkGuard *g = data;
+
+    guardTop = g->prev;
+    glpkGuardHook();
+}
+
+SEXP glpkGuardCall(const char *name, DL_FUNC fn, int nargs, SEXP *args) {
+
+    glpkGuard g;
+    SEXP out;
+
+    g.fn     = fn;
+    g.nargs  = nargs;
+    g.args   = args;
+    g.failed = 0;
+    g.prev   = guardTop;
+    guardTop = &g;
+
+    out = R_ExecWithCleanup(guardRun, &g, guardEnd, &g);
+
+    if (g.failed) {
+        /* a terminal hook installed by a solve points into a stack frame
+           that does not exist any longer */
+        glp_term_hook(NULL, NULL);
+        Rf_error("GLPK runtime error in '%s' (%.1f MB in use, limit %d MB), "
+                 "the problem object involved may be inconsistent!",
+                 name, glpkMemTotal() / 1048576.0, glpkMemLimit);
+    }
+
+    return out;
+}
@@ -0,0 +1,81 @@
+/* glpkMem.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <R_ext/Rdynload.h>
+
+
+/* -------------------------------------------------------------------------- */
+/* memory usage and memory limit of GLPK                                      */
+/* -------------------------------------------------------------------------- */
+
+/* GLPK stops with a runtime error if an allocation exceeds the limit set
+   with glp_mem_limit. Without an error hook, GLPK calls abort(), therefore
+   all entry points are run under a guard while a limit is set: a GLPK error
+   returns to the guard, which removes the hooks of GLPK and raises an R
+   error. Entry points installing their own error hook reinstall the guard
+   with glpkGuardHook() afterwards. */
+
+/* session memory limit in megabytes, 0 if none */
+extern int glpkMemLimit;
+
+/* memory in use by GLPK: number of blocks, peak number of blocks, bytes and
+   peak bytes (since start of the GLPK environment) */
+void glpkMemUsage(double *count, double *cpeak, double *total, double *tpeak);
+
+/* bytes in use by GLPK */
+double glpkMemTotal(void);
+
+/* set the memory limit (megabytes), mb <= 0 removes the limit */
+void glpkMemSetLimit(int mb);
+
+/* The external pointer of a problem object looks small to the garbage
+   collector of R, whatever the size of the problem is. Entry points allocating
+   GLPK memory for a problem (or releasing it) account the change of the bytes
+   in use to the problem object. If the bytes held by all problem objects grew
+   by more than glpkGcTrigger (or, if larger, by the amount held after the
+   last collection), a full garbage collection is run, which finalizes
+   problem objects no longer referenced in R. */
+
+/* minimum growth in bytes triggering a collection, 0 switches the trigger
+   off */
+extern double glpkGcTrigger;
+
+/* add the bytes allocated since mem0 (see glpkMemTotal) to *held, the
+   bytes held by one problem object; may run the garbage collector, so no
+   unprotected R objects must be alive */
+void glpkGcAccount(double *held, double mem0);
+
+/* the problem object holding *held bytes is deleted */
+void glpkGcRelease(double *held);
+
+/* bytes held by all problem objects */
+double glpkGcHeld(void);
+
+/* call fn with nargs arguments under a guard; name is used in the error
+   message */
+SEXP glpkGuardCall(const char *name, DL_FUNC fn, int nargs, SEXP *args);
+
+/* install the error hook of the current guard, if any; otherwise remove the
+   error hook */
+void glpkGuardHook(void);
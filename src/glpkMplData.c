@@ -0,0 +1,375 @@
+/* glpkMplData.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkSnapshot.h"
+#include "glpkMplData.h"
+
+#if defined(HAVE_PTHREAD) && !defined(_WIN32)
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#define GLPK_FEED_PIPE
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/* formatting                                                                 */
+/* -------------------------------------------------------------------------- */
+
+static int putStr(glpkBuf *buf, const char *str) {
+    return glpkBufPut(buf, str, strlen(str));
+}
+
+/* shortest representation of a double which reads back to the same value */
+static int putNum(glpkBuf *buf, double val) {
+
+    char num[32];
+
+    snprintf(num, sizeof(num), "%.15g", val);
+    if (strtod(num, NULL) != val) {
+        snprintf(num, sizeof(num), "%.17g", val);
+    }
+
+    return putStr(buf, num);
+}
+
+/* symbols are always quoted, embedded quotes are doubled */
+static int putSym(glpkBuf *buf, const char *str) {
+
+    const char *p;
+    int err = 0;
+
+    err |= glpkBufPut(buf, "'", 1);
+    for (p = str; *p != '\0'; p++) {
+        if (*p == '\'') {
+            err |= glpkBufPut(buf, "''", 2);
+        }
+        else {
+            err |= glpkBufPut(buf, p, 1);
+        }
+    }
+    err |= glpkBufPut(buf, "'", 1);
+
+    return err;
+}
+
+static int putElem(glpkBuf *buf, SEXP col, R_xlen_t i) {
+
+    char num[16];
+
+    switch (TYPEOF(col)) {
+        case INTSXP:
+            snprintf(num, sizeof(num), "%d", INTEGER(col)[i]);
+            return putStr(buf, num);
+        case REALSXP:
+            return putNum(buf, REAL(col)[i]);
+        default:
+            return putSym(buf, CHAR(STRING_ELT(col, i)));
+    }
+}
+
+static int isMissing(SEXP col, R_xlen_t i) {
+
+    switch (TYPEOF(col)) {
+        case INTSXP:
+            return (INTEGER(col)[i] == NA_INTEGER);
+        case REALSXP:
+            return (!R_FINITE(REAL(col)[i]));
+        default:
+            return (STRING_ELT(col, i) == NA_STRING);
+    }
+}
+
+/* check one named list of sets (nval = 0) or parameters (nval = 1) */
+static void checkData(SEXP data, const char *what, int nval) {
+
+    SEXP nms, ent, col;
+    R_xlen_t nr;
+    int k, c, nc;
+
+    if (data == R_NilValue) {
+        return;
+    }
+
+    nms = Rf_getAttrib(data, R_NamesSymbol);
+    if ( (TYPEOF(data) != VECSXP) || (nms == R_NilValue) ) {
+        Rf_error("Argument '%s' must be a named list!", what);
+    }
+
+    for (k = 0; k < Rf_length(data); k++) {
+        ent = VECTOR_ELT(data, k);
+        if ( (TYPEOF(ent) != VECSXP) || (Rf_length(ent) < 1) ) {
+            Rf_error("Invalid data for '%s'!", CHAR(STRING_ELT(nms, k)));
+        }
+        nc = Rf_length(ent);
+        nr = Rf_xlength(VECTOR_ELT(ent, 0));
+        for (c = 0; c < nc; c++) {
+            col = VECTOR_ELT(ent, c);
+            if ( (TYPEOF(col) != INTSXP) && (TYPEOF(col) != REALSXP) &&
+                 (TYPEOF(col) != STRSXP) ) {
+                Rf_error("Column %d of '%s' must be numeric or character!",
+                         c + 1, CHAR(STRING_ELT(nms, k)));
+            }
+            if (Rf_xlength(col) != nr) {
+                Rf_error("Columns of '%s' differ in length!",
+                         CHAR(STRING_ELT(nms, k)));
+            }
+        }
+        if ( (nval > 0) && (nc == 1) && (nr != 1) ) {
+            Rf_error("Parameter '%s' without subscripts must be of length 1!",
+                     CHAR(STRING_ELT(nms, k)));
+        }
+    }
+}
+
+/* set elements and subscripts must not be missing (the last nval columns
+   hold values) */
+static void checkIndex(SEXP data, int nval) {
+
+    SEXP nms, ent, col;
+    R_xlen_t i, nr;
+    int k, c, nc;
+
+    if (data == R_NilValue) {
+        return;
+    }
+
+    nms = Rf_getAttrib(data, R_NamesSymbol);
+
+    for (k = 0; k < Rf_length(data); k++) {
+        ent = VECTOR_ELT(data, k);
+        nc = Rf_length(ent) - nval;
+        for (c = 0; c < nc; c++) {
+            col = VECTOR_ELT(ent, c);
+            nr = Rf_xlength(col);
+            for (i = 0; i < nr; i++) {
+                if (isMissing(col, i)) {
+                    Rf_error("Missing or infinite element in '%s'!",
+                             CHAR(STRING_ELT(nms, k)));
+                }
+            }
+        }
+    }
+}
+
+int glpkMplFormatData(SEXP sets, SEXP params, glpkBuf *buf) {
+
+    SEXP nms, ent, val;
+    R_xlen_t i, nr;
+    int k, c, nc;
+    int err = 0;
+
+    checkData(sets, "sets", 0);
+    checkData(params, "params", 1);
+    checkIndex(sets, 0);
+    checkIndex(params, 1);
+
+    buf->len = 0;
+
+    err |= putStr(buf, "data;\n");
+
+    if (sets != R_NilValue) {
+        nms = Rf_getAttrib(sets, R_NamesSymbol);
+        for (k = 0; (k < Rf_length(sets)) && !err; k++) {
+            ent = VECTOR_ELT(sets, k);
+            nc = Rf_length(ent);
+            nr = Rf_xlength(VECTOR_ELT(ent, 0));
+            err |= putStr(buf, "set ");
+            err |= putStr(buf, CHAR(STRING_ELT(nms, k)));
+            err |= putStr(buf, " :=\n");
+            for (i = 0; (i < nr) && !err; i++) {
+                if (nc > 1) {
+                    err |= putStr(buf, "(");
+                }
+                for (c = 0; c < nc; c++) {
+                    if (c > 0) {
+                        err |= putStr(buf, ",");
+                    }
+                    err |= putElem(buf, VECTOR_ELT(ent, c), i);
+                }
+                err |= putStr(buf, (nc > 1) ? ")\n" : "\n");
+            }
+            err |= putStr(buf, ";\n");
+        }
+    }
+
+    if (params != R_NilValue) {
+        nms = Rf_getAttrib(params, R_NamesSymbol);
+        for (k = 0; (k < Rf_length(params)) && !err; k++) {
+            ent = VECTOR_ELT(params, k);
+            nc = Rf_length(ent);
+            val = VECTOR_ELT(ent, nc - 1);
+            nr = Rf_xlength(val);
+            if (nc == 1) {
+                /* scalar parameter, a missing value keeps the default */
+                if (!isMissing(val, 0)) {
+                    err |= putStr(buf, "param ");
+                    err |= putStr(buf, CHAR(STRING_ELT(nms, k)));
+                    err |= putStr(buf, " := ");
+                    err |= putElem(buf, val, 0);
+                    err |= putStr(buf, ";\n");
+                }
+                continue;
+            }
+            err |= putStr(buf, "param ");
+            err |= putStr(buf, CHAR(STRING_ELT(nms, k)));
+            err |= putStr(buf, " :=\n");
+            for (i = 0; (i < nr) && !err; i++) {
+                /* records with missing values keep the default */
+                if (isMissing(val, i)) {
+                    continue;
+                }
+                for (c = 0; c < nc; c++) {
+                    err |= putElem(buf, VECTOR_ELT(ent, c), i);
+                    err |= putStr(buf, (c < nc - 1) ? " " : "\n");
+                }
+            }
+            err |= putStr(buf, ";\n");
+        }
+    }
+
+    err |= putStr(buf, "end;\n");
+
+    return err;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* feeding GLPK                                                               */
+/* -------------------------------------------------------------------------- */
+
+#ifdef GLPK_FEED_PIPE
+
+/* writer thread: push the buffer into the pipe; if GLPK stops reading early
+   (syntax error or "end;"), the write fails with EPIPE instead of raising
+   SIGPIPE, which is blocked in this thread */
+static void *feedWriter(void *arg) {
+
+    glpkFeed *feed = arg;
+    const unsigned char *p = feed->buf->data;
+    size_t left = feed->buf->len;
+    ssize_t nw;
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+    while (left > 0) {
+        nw = write(feed->wfd, p, left);
+        if (nw < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        p += nw;
+        left -= (size_t) nw;
+    }
+
+    close(feed->wfd);
+
+    return NULL;
+}
+
+int glpkFeedOpen(glpkFeed *feed, const glpkBuf *buf, const char *tmpname) {
+
+    int fds[2];
+
+    feed->fname   = NULL;
+    feed->rfd     = -1;
+    feed->started = 0;
+
+    if (pipe(fds) != 0) {
+        return 1;
+    }
+
+    feed->rfd = fds[0];
+    feed->wfd = fds[1];
+    feed->buf = buf;
+
+    if (pthread_create(&feed->tid, NULL, feedWriter, feed) != 0) {
+        close(fds[0]);
+        close(fds[1]);
+        feed->rfd = -1;
+        return 1;
+    }
+
+    feed->started = 1;
+    snprintf(feed->dev, sizeof(feed->dev), "/dev/fd/%d", feed->rfd);
+    feed->fname = feed->dev;
+
+    return 0;
+}
+
+void glpkFeedClose(glpkFeed *feed) {
+
+    /* closing the read end releases a writer blocked on a full pipe */
+    if (feed->rfd >= 0) {
+        close(feed->rfd);
+        feed->rfd = -1;
+    }
+    if (feed->started) {
+        pthread_join(feed->tid, NULL);
+        feed->started = 0;
+    }
+    feed->fname = NULL;
+}
+
+#else
+
+int glpkFeedOpen(glpkFeed *feed, const glpkBuf *buf, const char *tmpname) {
+
+    feed->fname   = NULL;
+    feed->rfd     = -1;
+    feed->started = 0;
+
+    if (tmpname == NULL) {
+        return 1;
+    }
+
+    if (glpkSnapSave(buf, tmpname) != 0) {
+        return 1;
+    }
+
+    feed->started = 1;
+    feed->fname = tmpname;
+
+    return 0;
+}
+
+void glpkFeedClose(glpkFeed *feed) {
+
+    if (feed->started) {
+        remove(feed->fname);
+        feed->started = 0;
+    }
+    feed->fname = NULL;
+}
+
+#endif /* GLPK_FEED_PIPE */
@@ -0,0 +1,62 @@
+/* glpkMplData.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(HAVE_PTHREAD) && !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/* MathProg data sections from R objects                                      */
+/* -------------------------------------------------------------------------- */
+
+/* sets and params are named lists, each element is a list of columns of
+   equal length (integer, double or character). For a set, the columns are
+   the components of the tuples; for a parameter, the last column holds the
+   values and the other columns the subscripts. Invalid input raises an R
+   error before any memory is allocated. */
+
+/* format a data section into buf, returns zero on success */
+int glpkMplFormatData(SEXP sets, SEXP params, glpkBuf *buf);
+
+/* a file name from which GLPK reads the content of a buffer */
+typedef struct {
+    const char *fname;
+    char dev[32];
+    int rfd;
+    int started;
+#if defined(HAVE_PTHREAD) && !defined(_WIN32)
+    int wfd;
+    const glpkBuf *buf;
+    pthread_t tid;
+#endif
+} glpkFeed;
+
+/* make the buffer readable under feed->fname; the data are streamed through
+   a pipe where POSIX threads are available, otherwise they are written to
+   the file tmpname. Returns zero on success. */
+int glpkFeedOpen(glpkFeed *feed, const glpkBuf *buf, const char *tmpname);
+
+/* release pipe, writer thread or temporary file */
+void glpkFeedClose(glpkFeed *feed);
@@ -0,0 +1,239 @@
+/* glpkNorm.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkNorm.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* augmentation                                                               */
+/* -------------------------------------------------------------------------- */
+
+/* sign of x_j - r from the bounds of column j: 1 if never negative, -1 if
+   never positive, 0 if the column has to be split */
+static int normSign(glp_prob *P, int j, double r) {
+
+    int type = glp_get_col_type(P, j);
+
+    if ( ( (type == GLP_LO) || (type == GLP_DB) || (type == GLP_FX) ) &&
+         (glp_get_col_lb(P, j) >= r) ) {
+        return 1;
+    }
+    if ( ( (type == GLP_UP) || (type == GLP_DB) || (type == GLP_FX) ) &&
+         (glp_get_col_ub(P, j) <= r) ) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* row bounding the objective by its current optimal value */
+static void normFixObj(glp_prob *P, int i, int n, const double *c0,
+                       double frac, int dir, int *ja, double *ar) {
+
+    double z = glp_get_obj_val(P);
+    double slack = (1 - frac) * fabs(z);
+    int j, len = 0;
+
+    for (j = 1; j <= n; j++) {
+        if (c0[j] != 0) {
+            len++;
+            ja[len] = j;
+            ar[len] = c0[j];
+        }
+    }
+    glp_set_mat_row(P, i, len, ja, ar);
+
+    /* the constant term is not part of the row */
+    z -= c0[0];
+    if (dir == GLP_MAX) {
+        glp_set_row_bnds(P, i, GLP_LO, z - slack, 0);
+    }
+    else {
+        glp_set_row_bnds(P, i, GLP_UP, 0, z + slack);
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkNormL1(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+               int nc, const int *ind, const double *ref, const double *w,
+               double frac, double *prim, double *norm, int *stat) {
+
+    glp_smcp lparm = *parm;
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int dir = glp_get_obj_dir(P);
+    int warm = ( (glp_get_status(P) == GLP_OPT) ||
+                 (glp_get_status(P) == GLP_FEAS) );
+    double *c0, *ar;
+    int *rstat, *cstat, *sgn, *ja;
+    int i, j, k, t, nsplit = 0, nrows, ret;
+    double r, wk, d;
+
+    *norm = R_NaN;
+    *stat = 0;
+
+    c0    = malloc(((size_t) n + 1) * sizeof(double));
+    ar    = malloc(((size_t) n + 4) * sizeof(double));
+    rstat = malloc(((size_t) m + 1) * sizeof(int));
+    cstat = malloc(((size_t) n + 1) * sizeof(int));
+    sgn   = malloc(((size_t) nc + 1) * sizeof(int));
+    /* also used for the numbers of the rows and columns to delete */
+    ja    = malloc(((size_t) n + 2 * (size_t) nc + 2) * sizeof(int));
+
+    if ( (c0 == NULL) || (ar == NULL) || (rstat == NULL) ||
+         (cstat == NULL) || (sgn == NULL) || (ja == NULL) ) {
+        free(c0);
+        free(ar);
+        free(rstat);
+        free(cstat);
+        free(sgn);
+        free(ja);
+        return -1;
+    }
+
+    for (i = 1; i <= m; i++) {
+        rstat[i] = glp_get_row_stat(P, i);
+    }
+    for (j = 0; j <= n; j++) {
+        c0[j] = glp_get_obj_coef(P, j);
+        if (j > 0) {
+            cstat[j] = glp_get_col_stat(P, j);
+        }
+    }
+
+    for (k = 0; k < nc; k++) {
+        sgn[k] = normSign(P, ind[k], (ref == NULL) ? 0 : ref[k]);
+        if (sgn[k] == 0) {
+            nsplit++;
+        }
+    }
+
+    nrows = nsplit + ( (frac >= 0) ? 1 : 0 );
+    if (nrows > 0) {
+        glp_add_rows(P, nrows);
+    }
+    if (nsplit > 0) {
+        glp_add_cols(P, 2 * nsplit);
+    }
+
+    /* the objective is the norm */
+    if (frac >= 0) {
+        normFixObj(P, m + nrows, n, c0, frac, dir, ja, ar);
+    }
+    for (j = 0; j <= n; j++) {
+        glp_set_obj_coef(P, j, 0);
+    }
+    glp_set_obj_dir(P, GLP_MIN);
+
+    t = 0;
+    for (k = 0; k < nc; k++) {
+        j  = ind[k];
+        r  = (ref == NULL) ? 0 : ref[k];
+        wk = (w == NULL) ? 1 : w[k];
+        if (sgn[k] != 0) {
+            glp_set_obj_coef(P, j, glp_get_obj_coef(P, j) + sgn[k] * wk);
+            glp_set_obj_coef(P, 0, glp_get_obj_coef(P, 0) - sgn[k] * wk * r);
+            continue;
+        }
+
+        /* x_j - p + n = r */
+        i = m + 1 + t;
+        ja[1] = j;             ar[1] = 1;
+        ja[2] = n + 1 + 2 * t; ar[2] = -1;
+        ja[3] = n + 2 + 2 * t; ar[3] = 1;
+        glp_set_mat_row(P, i, 3, ja, ar);
+        glp_set_row_bnds(P, i, GLP_FX, r, r);
+        glp_set_col_bnds(P, ja[2], GLP_LO, 0, 0);
+        glp_set_col_bnds(P, ja[3], GLP_LO, 0, 0);
+        glp_set_obj_coef(P, ja[2], wk);
+        glp_set_obj_coef(P, ja[3], wk);
+
+        /* the split column of the sign of x_j - r replaces the linking row
+           in the basis */
+        if (warm) {
+            d = glp_get_col_prim(P, j) - r;
+            glp_set_row_stat(P, i, GLP_NS);
+            glp_set_col_stat(P, (d >= 0) ? ja[2] : ja[3], GLP_BS);
+        }
+        t++;
+    }
+
+    lparm.meth     = GLP_PRIMAL;
+    lparm.presolve = GLP_OFF;
+
+    ret = glpkSolveSimplex(P, &lparm, info);
+
+    if ( (ret == 0) || (ret == GLP_ETMLIM) || (ret == GLP_EITLIM) ) {
+        *stat = glp_get_status(P);
+        if (*stat == GLP_OPT) {
+            *norm = glp_get_obj_val(P);
+        }
+    }
+    for (j = 1; j <= n; j++) {
+        prim[j-1] = glp_get_col_prim(P, j);
+    }
+
+    /* remove the augmentation */
+    if (nrows > 0) {
+        for (t = 1; t <= nrows; t++) {
+            ja[t] = m + t;
+        }
+        glp_del_rows(P, nrows, ja);
+    }
+    if (nsplit > 0) {
+        for (t = 1; t <= 2 * nsplit; t++) {
+            ja[t] = n + t;
+        }
+        glp_del_cols(P, 2 * nsplit, ja);
+    }
+
+    for (i = 1; i <= m; i++) {
+        glp_set_row_stat(P, i, rstat[i]);
+    }
+    for (j = 0; j <= n; j++) {
+        glp_set_obj_coef(P, j, c0[j]);
+        if (j > 0) {
+            glp_set_col_stat(P, j, cstat[j]);
+        }
+    }
+    glp_set_obj_dir(P, dir);
+
+    free(c0);
+    free(ar);
+    free(rstat);
+    free(cstat);
+    free(sgn);
+    free(ja);
+
+    return ret;
+}
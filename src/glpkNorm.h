@@ -0,0 +1,48 @@
+/* glpkNorm.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* minimal weighted L1 norm                                                   */
+/* -------------------------------------------------------------------------- */
+
+/* Minimize sum_k w[k] |x_j - ref[k]| over the columns j = ind[k] (1-based,
+   nc elements) on the polytope of P, e.g. for parsimonious FBA (ref = 0) or
+   linear MOMA. ref and w may be NULL (all zero, all one). If frac >= 0, the
+   current optimal objective value z of P is kept up to a fraction: an
+   additional row bounds the objective by z -/+ (1 - frac) |z|.
+
+   P is augmented in place: a column whose bounds give the sign of
+   x_j - ref[k] enters the norm directly, every other one gets a pair of
+   split columns p, n >= 0 and the linking row x_j - p + n = ref[k]. From a
+   solution of P, the split columns start basic, so the primal simplex
+   method starts from a feasible basis. Afterwards, all added rows and
+   columns are removed and objective and basis of P are restored.
+
+   prim (n elements) receives the column primal values, *norm the value of
+   the norm (NaN if not optimal), *stat the solution status. Returns the
+   return code of glpkSolveSimplex, -1 if out of memory. */
+int glpkNormL1(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+               int nc, const int *ind, const double *ref, const double *w,
+               double frac, double *prim, double *norm, int *stat);
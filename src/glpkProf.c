@@ -0,0 +1,169 @@
+/* glpkProf.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <stdarg.h>
+#include "glpkR.h"
+#include "glpkProf.h"
+
+
+int glpkProfEnabled = 0;
+
+static int profNum = 0;
+static const char **profNames = NULL;
+static double *profCalls = NULL;
+static double *profTime  = NULL;
+static double *profMax   = NULL;
+static double *profElem  = NULL;
+
+
+/* -------------------------------------------------------------------------- */
+/* timer                                                                      */
+/* -------------------------------------------------------------------------- */
+
+double glpkProfTime(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, cnt;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (double) cnt.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* counters                                                                   */
+/* -------------------------------------------------------------------------- */
+
+void glpkProfInit(int n, const char **names) {
+
+    profNum   = n;
+    profNames = names;
+    profCalls = (double *) calloc((size_t) n, sizeof(double));
+    profTime  = (double *) calloc((size_t) n, sizeof(double));
+    profMax   = (double *) calloc((size_t) n, sizeof(double));
+    profElem  = (double *) calloc((size_t) n, sizeof(double));
+
+    if ( (profCalls == NULL) || (profTime == NULL) ||
+         (profMax == NULL) || (profElem == NULL) ) {
+        free(profCalls);
+        free(profTime);
+        free(profMax);
+        free(profElem);
+        profCalls = profTime = profMax = profElem = NULL;
+        profNum = 0;
+    }
+}
+
+double glpkProfStart(int id) {
+
+    /* counted before the call, calls ending in an R error are not timed */
+    if (id < profNum) {
+        profCalls[id]++;
+    }
+
+    return glpkProfTime();
+}
+
+void glpkProfStop(int id, double t0, double nelem) {
+
+    double dt = glpkProfTime() - t0;
+
+    if (id < profNum) {
+        profTime[id] += dt;
+        profElem[id] += nelem;
+        if (dt > profMax[id]) {
+            profMax[id] = dt;
+        }
+    }
+}
+
+static double vecLength(SEXP x) {
+    switch (TYPEOF(x)) {
+        case LGLSXP:
+        case INTSXP:
+        case REALSXP:
+        case STRSXP:
+        case VECSXP:
+            return (double) Rf_xlength(x);
+        default:
+            return 0;
+    }
+}
+
+double glpkProfElements(SEXP out, int nargs, ...) {
+
+    va_list ap;
+    double len, nelem = vecLength(out);
+    int k;
+
+    va_start(ap, nargs);
+    for (k = 0; k < nargs; k++) {
+        len = vecLength(va_arg(ap, SEXP));
+        if (len > nelem) {
+            nelem = len;
+        }
+    }
+    va_end(ap);
+
+    return nelem;
+}
+
+void glpkProfSet(int on) {
+    glpkProfEnabled = (on != 0) && (profNum > 0);
+}
+
+void glpkProfReset(void) {
+
+    int k;
+
+    for (k = 0; k < profNum; k++) {
+        profCalls[k] = 0;
+        profTime[k]  = 0;
+        profMax[k]   = 0;
+        profElem[k]  = 0;
+    }
+}
+
+int glpkProfInfo(const char ***names, const double **calls,
+                 const double **time, const double **tmax,
+                 const double **nelem) {
+
+    *names = profNames;
+    *calls = profCalls;
+    *time  = profTime;
+    *tmax  = profMax;
+    *nelem = profElem;
+
+    return profNum;
+}
@@ -0,0 +1,62 @@
+/* glpkProf.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* profiling of the .Call entry points                                        */
+/* -------------------------------------------------------------------------- */
+
+/* The entry points registered in init.c are wrapped; a wrapper tests
+   glpkProfEnabled and calls the entry point directly if profiling is
+   switched off. */
+
+/* nonzero, if profiling is switched on */
+extern int glpkProfEnabled;
+
+/* wall clock time in seconds (monotonic, arbitrary origin) */
+double glpkProfTime(void);
+
+/* set up the table of entry points, called from R_init_glpkAPI */
+void glpkProfInit(int n, const char **names);
+
+/* count a call of entry point id, returns the start time */
+double glpkProfStart(int id);
+
+/* record time and number of elements of a finished call */
+void glpkProfStop(int id, double t0, double nelem);
+
+/* number of elements processed: the largest length of the vector
+   arguments and the result */
+double glpkProfElements(SEXP out, int nargs, ...);
+
+/* switch profiling on or off */
+void glpkProfSet(int on);
+
+/* clear all counters */
+void glpkProfReset(void);
+
+/* number of entry points and their counters */
+int glpkProfInfo(const char ***names, const double **calls,
+                 const double **time, const double **tmax,
+                 const double **nelem);
@@ -48,45 +48,63 @@
 
 /* -------------------------------------------------------------------------- */
 /* check arguments to GLPK */
+
+/* Checks are compiled in with CHECK_GLPK_ARGS and can be switched off at
+   runtime (glpkCheckArgs = 0, see setCheckArgs). */
+extern int glpkCheckArgs;
+
+/* Index vectors are validated with one pass computing minimum and maximum;
+   only if that fails, a second pass locates the offending element.
+   Elements before index first are skipped (dummy element 0 of GLPK). */
+void glpkCheckIndices(SEXP x, int first, int nmax, const char *what,
+                      const char *arg);
+
 #ifdef CHECK_GLPK_ARGS
 #define checkRowIndex(p, r) do { \
-    if ( (Rf_asInteger(r) > glp_get_num_rows(R_ExternalPtrAddr(p))) || \
-         (Rf_asInteger(r) < 1) ) \
+    if ( glpkCheckArgs && \
+         ( (Rf_asInteger(r) > glp_get_num_rows(R_ExternalPtrAddr(p))) || \
+           (Rf_asInteger(r) < 1) ) ) \
         Rf_error("Row index '%i' is out of range!", Rf_asInteger(r)); \
 } while (0)
 #define checkColIndex(p, c) do { \
-    if ( (Rf_asInteger(c) > glp_get_num_cols(R_ExternalPtrAddr(p))) || \
-         (Rf_asInteger(c) < 1) ) \
+    if ( glpkCheckArgs && \
+         ( (Rf_asInteger(c) > glp_get_num_cols(R_ExternalPtrAddr(p))) || \
+           (Rf_asInteger(c) < 1) ) ) \
         Rf_error("Column index '%i' is out of range!", Rf_asInteger(c)); \
 } while (0)
 #define checkVarType(v) do { \
-    if ( (Rf_asInteger(v) > GLP_FX) || (Rf_asInteger(v) < GLP_FR) ) \
+    if ( glpkCheckArgs && \
+         ( (Rf_asInteger(v) > GLP_FX) || (Rf_asInteger(v) < GLP_FR) ) ) \
         Rf_error("Invalid variable type '%i'!", Rf_asInteger(v)); \
 } while (0)
 #define checkVarKind(v) do { \
     int rv = Rf_asInteger(v); \
-    if ( (rv != GLP_CV) && (rv != GLP_IV) && (rv != GLP_BV) ) \
+    if ( glpkCheckArgs && \
+         (rv != GLP_CV) && (rv != GLP_IV) && (rv != GLP_BV) ) \
         Rf_error("Invalid variable kind '%i'!", Rf_asInteger(v)); \
 } while (0)
 #define checkVarStat(v) do { \
     int rv = Rf_asInteger(v); \
-    if ( (rv != GLP_BS) && (rv != GLP_NL) && (rv != GLP_NU)  && (rv != GLP_NF) && (rv != GLP_NS) ) \
+    if ( glpkCheckArgs && \
+         (rv != GLP_BS) && (rv != GLP_NL) && (rv != GLP_NU)  && (rv != GLP_NF) && (rv != GLP_NS) ) \
         Rf_error("Invalid variable status '%i'!", Rf_asInteger(v)); \
 } while (0)
 #define checkSolType(v) do { \
     int rv = Rf_asInteger(v); \
-    if ( (rv != GLP_SOL) && (rv != GLP_IPT) && (rv != GLP_MIP) ) \
+    if ( glpkCheckArgs && \
+         (rv != GLP_SOL) && (rv != GLP_IPT) && (rv != GLP_MIP) ) \
         Rf_error("Invalid variable status '%i'!", Rf_asInteger(v)); \
 } while (0)
 #define checkScaling(v) do { \
     int rv = Rf_asInteger(v); \
-    if ( (rv != GLP_SF_GM) && (rv != GLP_SF_EQ) && (rv != GLP_SF_2N) && (rv != GLP_SF_SKIP) && (rv != GLP_SF_AUTO) ) \
+    if ( glpkCheckArgs && \
+         (rv != GLP_SF_GM) && (rv != GLP_SF_EQ) && (rv != GLP_SF_2N) && (rv != GLP_SF_SKIP) && (rv != GLP_SF_AUTO) ) \
         Rf_error("Invalid scaling option '%i'!", Rf_asInteger(v)); \
 } while (0)
 #define checkVarTypes(v) do { \
     int y = 0; \
     const int *rv; \
-    if (TYPEOF(v) == INTSXP) { \
+    if ( glpkCheckArgs && (TYPEOF(v) == INTSXP) ) { \
         rv = INTEGER(v); \
         while (y < Rf_length(v)) { \
             if ( ((rv[y]) > GLP_FX) || ((rv[y]) < GLP_FR) ) { \
@@ -99,7 +117,7 @@
 #define checkVarKinds(v) do { \
     int y = 0; \
     const int *rv; \
-    if (TYPEOF(v) == INTSXP) { \
+    if ( glpkCheckArgs && (TYPEOF(v) == INTSXP) ) { \
         rv = INTEGER(v); \
         while (y < Rf_length(v)) { \
             if ( ((rv[y]) != GLP_CV) && ((rv[y]) != GLP_IV) && ((rv[y]) != GLP_BV) ) { \
@@ -110,29 +128,17 @@
     } \
 } while (0)
 #define checkRowIndices(p, r, s) do { \
-    int y = s ? 1 : 0; \
-    int nr = glp_get_num_rows(R_ExternalPtrAddr(p)); \
-    const int *rr = INTEGER(r); \
-    while (y < Rf_length(r)) { \
-        if ( ((rr[y]) > nr) || ((rr[y]) < 1) ) { \
-            Rf_error("Row index 'i[%i] = %i' is out of range!", s ? y : (y+1), rr[y]); \
-        } \
-        y++; \
-    } \
+    if (glpkCheckArgs) \
+        glpkCheckIndices(r, s ? 1 : 0, \
+                         glp_get_num_rows(R_ExternalPtrAddr(p)), "Row", "i"); \
 } while (0)
 #define checkColIndices(p, c, s) do { \
-    int y = s ? 1 : 0; \
-    int nc = glp_get_num_cols(R_ExternalPtrAddr(p)); \
-    const int *rc = INTEGER(c); \
-    while (y < Rf_length(c)) { \
-        if ( ((rc[y]) > nc) || ((rc[y]) < 1) ) { \
-            Rf_error("Column index 'j[%i] = %i' is out of range!", s ? y : (y+1), rc[y]); \
-        } \
-        y++; \
-    } \
+    if (glpkCheckArgs) \
+        glpkCheckIndices(c, s ? 1 : 0, \
+                         glp_get_num_cols(R_ExternalPtrAddr(p)), "Column", "j"); \
 } while (0)
 #define checkVecLen(l, v) do { \
-    if ( Rf_length(v) != Rf_asInteger(l) ) { \
+    if ( glpkCheckArgs && (Rf_length(v) != Rf_asInteger(l)) ) { \
         Rf_error("Vector does not have length %i!", Rf_asInteger(l)); \
     } \
 } while (0)
@@ -144,6 +150,8 @@
     int y = 1; \
     const int *rm = INTEGER(m); \
     const int *rn = INTEGER(n); \
+    if (!glpkCheckArgs) \
+        break; \
     oind = R_Calloc(Rf_asInteger(ne), int); \
     R_orderVector(oind, Rf_asInteger(ne), PROTECT(Rf_lang2(m, n)), TRUE, FALSE); \
     while (y < Rf_asInteger(ne)) { \
@@ -173,8 +181,8 @@
 #define checkScaling(v)
 #define checkVarTypes(v)
 #define checkVarKinds(v)
-#define checkRowIndices(p, r)
-#define checkColIndices(p, c)
+#define checkRowIndices(p, r, s)
+#define checkColIndices(p, c, s)
 #define checkVecLen(l, v)
 #define checkDupIndices(m, n, ne)
 #endif
@@ -0,0 +1,250 @@
+/* glpkRace.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "glpkR.h"
+#include "glpkProf.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkSnapshot.h"
+#include "glpkCross.h"
+#include "glpkTeam.h"
+#include "glpkRace.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* workers                                                                    */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    glp_prob *P;             /* problem of the caller, only read */
+    int m;
+    int n;
+    int nmeth;
+    int meth[3];             /* GLPK_RACE_* of worker w */
+    glp_smcp smcp;
+    glp_iptcp iptcp;
+    int budget;              /* tm_lim lowered by the time budget */
+    int stopped;             /* a worker was stopped by its budget share */
+    int fail;                /* first return code of a failed worker */
+    int winner;
+    double tdone;
+    int *rstat;              /* basis of the winner */
+    int *cstat;
+} raceShared;
+
+/* a final status: optimal, or infeasibility or unboundedness proven */
+static int raceFinal(glp_prob *Q) {
+
+    int stat = glp_get_status(Q);
+
+    return ( (stat == GLP_OPT) || (stat == GLP_NOFEAS) ||
+             (stat == GLP_UNBND) );
+}
+
+/* a cancelled worker leaves through the error hook of the team, releasing
+   Q with its GLPK environment */
+static void raceWorker(glpkTeam *tm, int w, void *data) {
+
+    raceShared *sh = data;
+    int method = sh->meth[w];
+    glp_smcp smcp = sh->smcp;
+    glp_iptcp iptcp = sh->iptcp;
+    glp_prob *Q;
+    glpkCrossStat cst;
+    int i, j, ret = 0, ok = 0, stop = 0;
+
+    /* the terminal hook is called only while progress is printed */
+    smcp.msg_lev  = GLP_MSG_ON;
+    smcp.out_frq  = GLPK_POLL_OUT_FRQ;
+    iptcp.msg_lev = GLP_MSG_ON;
+    smcp.meth = (method == GLPK_RACE_DUAL) ? GLP_DUALP : GLP_PRIMAL;
+    if (method == GLPK_RACE_INTERIOR) {
+        /* after the crossover */
+        smcp.presolve = GLP_OFF;
+    }
+
+    Q = glp_create_prob();
+    glp_copy_prob(Q, sh->P, GLP_OFF);
+
+    if (method == GLPK_RACE_INTERIOR) {
+        ret = glp_interior(Q, &iptcp);
+        if ( (ret == 0) && (glp_ipt_status(Q) == GLP_OPT) ) {
+            glpkCrossBasis(Q, &cst);
+            ret = glp_simplex(Q, &smcp);
+            ok  = ( (ret == 0) && (glp_get_status(Q) == GLP_OPT) );
+        }
+    }
+    else {
+        ret = glp_simplex(Q, &smcp);
+        ok  = ( (ret == 0) && (raceFinal(Q)) );
+    }
+
+    glpkTeamLock(tm);
+    if (!ok) {
+        if ( (ret == GLP_ETMLIM) && (sh->budget) ) {
+            /* the share of the time budget is used up for all workers */
+            sh->stopped = 1;
+            stop = 1;
+        }
+        if (sh->fail == 0) {
+            sh->fail = (ret != 0) ? ret : GLP_EFAIL;
+        }
+    }
+    else if (sh->winner == 0) {
+        sh->winner = method;
+        sh->tdone  = glpkProfTime();
+        for (i = 1; i <= sh->m; i++) {
+            sh->rstat[i] = glp_get_row_stat(Q, i);
+        }
+        for (j = 1; j <= sh->n; j++) {
+            sh->cstat[j] = glp_get_col_stat(Q, j);
+        }
+        stop = 1;
+    }
+    glpkTeamUnlock(tm);
+
+    if (stop) {
+        glpkTeamCancel(tm);
+    }
+
+    glp_delete_prob(Q);
+}
+
+/* Lowers the time limit of the simplex workers to the share of the time
+   budget of the session (see glpkBudgetSet), without taking it: the final
+   solve takes it. Returns nonzero if the deadline has passed. */
+static int raceBudget(raceShared *sh) {
+
+    double rem, left, skipped, stopped, share;
+
+    sh->budget = 0;
+
+    if (!glpkBudgetGet(&rem, &left, &skipped, &stopped)) {
+        return 0;
+    }
+    if (rem <= 0) {
+        return 1;
+    }
+
+    share = ceil(((left > 1) ? rem / left : rem) * 1000.0);
+    if (share < (double) sh->smcp.tm_lim) {
+        sh->smcp.tm_lim = (share < 1) ? 1 : (int) share;
+        sh->budget      = 1;
+    }
+
+    return 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkRace(glp_prob *P, const glp_smcp *smcp, const glp_iptcp *iptcp,
+             int methods, glpkProbInfo *info, glpkRaceStat *st) {
+
+    static const int meth[3] = { GLPK_RACE_PRIMAL, GLPK_RACE_DUAL,
+                                 GLPK_RACE_INTERIOR };
+    glp_smcp lparm = *smcp;
+    double t0 = glpkProfTime();
+    int ret;
+    raceShared sh;
+    int i, j, k, intr = 0;
+
+    st->winner   = 0;
+    st->nthreads = 0;
+    st->secs     = 0;
+
+    if ( (glpkTeamAvailable(1)) && (glp_get_num_rows(P) > 0) ) {
+        sh.P       = P;
+        sh.m       = glp_get_num_rows(P);
+        sh.n       = glp_get_num_cols(P);
+        sh.nmeth   = 0;
+        sh.smcp    = *smcp;
+        sh.iptcp   = *iptcp;
+        sh.stopped = 0;
+        sh.fail    = 0;
+        sh.winner  = 0;
+        sh.tdone   = t0;
+        sh.rstat   = malloc(((size_t) sh.m + 1) * sizeof(int));
+        sh.cstat   = malloc(((size_t) sh.n + 1) * sizeof(int));
+
+        for (k = 0; k < 3; k++) {
+            if ( (methods & meth[k]) != 0 ) {
+                sh.meth[sh.nmeth++] = meth[k];
+            }
+        }
+
+        if ( (sh.rstat != NULL) && (sh.cstat != NULL) &&
+             (raceBudget(&sh) == 0) ) {
+            st->nthreads = glpkTeamRun(sh.nmeth, 1, raceWorker, &sh, &intr);
+        }
+
+        if (sh.winner != 0) {
+            for (i = 1; i <= sh.m; i++) {
+                glp_set_row_stat(P, i, sh.rstat[i]);
+            }
+            for (j = 1; j <= sh.n; j++) {
+                glp_set_col_stat(P, j, sh.cstat[j]);
+            }
+            st->winner = sh.winner;
+            st->secs   = sh.tdone - t0;
+            /* the solution itself can not be copied between problem
+               objects, it is computed again from the basis */
+            lparm.meth     = (sh.winner == GLPK_RACE_DUAL) ? GLP_DUALP
+                                                           : GLP_PRIMAL;
+            lparm.presolve = GLP_OFF;
+        }
+
+        free(sh.rstat);
+        free(sh.cstat);
+
+        if ( (sh.winner == 0) && (st->nthreads > 0) ) {
+            /* user interrupt, budget share used up or all methods failed;
+               the race counts as one solve of the budget */
+            if (intr) {
+                ret = GLPK_EINTR;
+            }
+            else {
+                ret = (sh.stopped) ? GLPK_EBUDGET :
+                      ( (sh.fail != 0) ? sh.fail : GLP_EFAIL );
+                glpkBudgetCount(1, sh.stopped, 0);
+            }
+            st->secs = glpkProfTime() - t0;
+            glpkStatRecord(GLPK_SOLVER_SIMPLEX, st->secs, -1, ret);
+            return ret;
+        }
+    }
+
+    /* without threads the problem is solved as usual */
+    ret = glpkSolveSimplex(P, &lparm, info);
+
+    if (st->winner == 0) {
+        st->secs = glpkProfTime() - t0;
+    }
+
+    return ret;
+}
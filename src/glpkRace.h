@@ -0,0 +1,57 @@
+/* glpkRace.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* concurrent solves                                                          */
+/* -------------------------------------------------------------------------- */
+
+/* Primal simplex, dual simplex and interior point method (followed by the
+   crossover, see glpkCross.h) run at the same time on copies of the
+   problem, each in its own thread with its own GLPK environment. The first
+   method reaching a final status wins, the others are cancelled through the
+   terminal hook. The basis of the winner is installed in the problem of the
+   caller, which is then solved once more from it by the simplex method of
+   the winner (primal after the interior point method), usually without
+   iterations. The simplex workers get the share of the time budget of the
+   session as time limit; if it stops one of them, the race ends with
+   GLPK_EBUDGET. Without a winner, the problem of the caller is not solved.
+   Without threads, or if GLPK is not thread safe, the problem is solved by
+   glpkSolveSimplex only. */
+
+/* methods */
+#define GLPK_RACE_PRIMAL   1
+#define GLPK_RACE_DUAL     2
+#define GLPK_RACE_INTERIOR 4
+
+typedef struct {
+    int winner;      /* GLPK_RACE_* of the winner, 0 if none */
+    int nthreads;    /* threads started */
+    double secs;     /* wall clock time until the winner finished */
+} glpkRaceStat;
+
+/* methods is a combination of GLPK_RACE_*; returns the return code of the
+   final simplex solve, or of the race if there was no winner */
+int glpkRace(glp_prob *P, const glp_smcp *smcp, const glp_iptcp *iptcp,
+             int methods, glpkProbInfo *info, glpkRaceStat *st);
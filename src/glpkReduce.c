@@ -0,0 +1,756 @@
+/* glpkReduce.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkReduce.h"
+
+/* column values of the solution are at a bound within this tolerance */
+#define REDUCE_EPS 1e-7
+
+
+/* -------------------------------------------------------------------------- */
+/* reduction                                                                  */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    int m;
+    int n;
+    int *rbeg;               /* row-wise matrix, row i is rind/rval[rbeg[i]]
+                                up to rind/rval[rbeg[i+1] - 1] */
+    int *rind;
+    double *rval;
+    int *cbeg;               /* column-wise matrix */
+    int *cind;
+    double *cval;
+    double *rlo;             /* current bounds, -/+HUGE_VAL if missing */
+    double *rup;
+    double *clo;
+    double *cup;
+    double *c;               /* objective coefficients */
+    double c0;               /* objective constant of fixed columns */
+    int *kind;
+    int *rlive;
+    int *clive;
+    int *rcnt;               /* number of live columns in row */
+    int cap;                 /* room for reductions */
+    glpkReduceMap *map;
+    double tol;
+} redCtx;
+
+static void redPush(redCtx *rc, int type, int row, int col, int flag,
+                    double a, double lo, double up) {
+
+    glpkReduceMap *mp = rc->map;
+    int k = mp->nop++;
+
+    mp->iop[k]               = type;
+    mp->iop[rc->cap + k]     = row;
+    mp->iop[2 * rc->cap + k] = col;
+    mp->iop[3 * rc->cap + k] = flag;
+    mp->dop[k]               = a;
+    mp->dop[rc->cap + k]     = lo;
+    mp->dop[2 * rc->cap + k] = up;
+}
+
+/* fix column j at v; a is its coefficient in the forcing row row */
+static void redFix(redCtx *rc, int j, double v, int row, double a) {
+
+    int k, i;
+
+    redPush(rc, GLPK_RED_FIXCOL, row, j, 0, a, v, v);
+
+    rc->clive[j] = 0;
+    rc->clo[j]   = v;
+    rc->cup[j]   = v;
+    rc->c0      += rc->c[j] * v;
+
+    for (k = rc->cbeg[j]; k < rc->cbeg[j+1]; k++) {
+        i = rc->cind[k];
+        if (rc->rlive[i]) {
+            rc->rlo[i] -= rc->cval[k] * v;
+            rc->rup[i] -= rc->cval[k] * v;
+            rc->rcnt[i]--;
+        }
+    }
+}
+
+/* scaled tolerance */
+static double redTol(const redCtx *rc, double b) {
+    return rc->tol * (1.0 + fabs(b));
+}
+
+static int redSingleton(redCtx *rc, int i) {
+
+    int k, j = 0, flag = 0;
+    double a = 0, lo, up;
+
+    for (k = rc->rbeg[i]; k < rc->rbeg[i+1]; k++) {
+        if (rc->clive[rc->rind[k]]) {
+            j = rc->rind[k];
+            a = rc->rval[k];
+            break;
+        }
+    }
+
+    lo = rc->rlo[i] / a;
+    up = rc->rup[i] / a;
+    if (a < 0) {
+        lo = rc->rup[i] / a;
+        up = rc->rlo[i] / a;
+    }
+    if (rc->kind[j] != GLP_CV) {
+        lo = ceil(lo - rc->tol);
+        up = floor(up + rc->tol);
+    }
+
+    if (lo > rc->clo[j] + redTol(rc, lo)) {
+        rc->clo[j] = lo;
+        flag |= 1;
+    }
+    if (up < rc->cup[j] - redTol(rc, up)) {
+        rc->cup[j] = up;
+        flag |= 2;
+    }
+    if (rc->clo[j] > rc->cup[j]) {
+        if (rc->clo[j] > rc->cup[j] + redTol(rc, rc->cup[j])) {
+            return GLP_ENOPFS;
+        }
+        if (flag & 1) {
+            rc->cup[j] = rc->clo[j];
+        }
+        else {
+            rc->clo[j] = rc->cup[j];
+        }
+    }
+
+    redPush(rc, GLPK_RED_SINGLETON, i, j, flag, a, rc->clo[j], rc->cup[j]);
+    rc->rlive[i] = 0;
+
+    return 0;
+}
+
+/* redundant and forcing rows, from the bounds of the row activity */
+static int redActivity(redCtx *rc, int i, int *changed) {
+
+    int k, j, op, nfix = 0;
+    double a, lo = 0, up = 0;
+
+    for (k = rc->rbeg[i]; k < rc->rbeg[i+1]; k++) {
+        j = rc->rind[k];
+        if (rc->clive[j]) {
+            a = rc->rval[k];
+            lo += a * ((a > 0) ? rc->clo[j] : rc->cup[j]);
+            up += a * ((a > 0) ? rc->cup[j] : rc->clo[j]);
+        }
+    }
+
+    if ( ( (rc->rlo[i] == -HUGE_VAL) ||
+           (lo >= rc->rlo[i] - redTol(rc, rc->rlo[i])) ) &&
+         ( (rc->rup[i] == HUGE_VAL) ||
+           (up <= rc->rup[i] + redTol(rc, rc->rup[i])) ) ) {
+        redPush(rc, GLPK_RED_REDUNDANT, i, 0, 0, 0, lo, up);
+        rc->rlive[i] = 0;
+        *changed = 1;
+        return 0;
+    }
+
+    if ( (lo > rc->rup[i] + redTol(rc, rc->rup[i])) ||
+         (up < rc->rlo[i] - redTol(rc, rc->rlo[i])) ) {
+        return GLP_ENOPFS;
+    }
+
+    if ( (rc->rup[i] != HUGE_VAL) &&
+         (lo >= rc->rup[i] - redTol(rc, rc->rup[i])) ) {
+        /* all columns at the bound of least activity */
+        op = rc->map->nop;
+        redPush(rc, GLPK_RED_FORCING, i, 0, 2, 0, lo, up);
+        rc->rlive[i] = 0;
+        for (k = rc->rbeg[i]; k < rc->rbeg[i+1]; k++) {
+            j = rc->rind[k];
+            if (rc->clive[j]) {
+                a = rc->rval[k];
+                redFix(rc, j, (a > 0) ? rc->clo[j] : rc->cup[j], i, a);
+                nfix++;
+            }
+        }
+    }
+    else if ( (rc->rlo[i] != -HUGE_VAL) &&
+              (up <= rc->rlo[i] + redTol(rc, rc->rlo[i])) ) {
+        /* all columns at the bound of largest activity */
+        op = rc->map->nop;
+        redPush(rc, GLPK_RED_FORCING, i, 0, 1, 0, lo, up);
+        rc->rlive[i] = 0;
+        for (k = rc->rbeg[i]; k < rc->rbeg[i+1]; k++) {
+            j = rc->rind[k];
+            if (rc->clive[j]) {
+                a = rc->rval[k];
+                redFix(rc, j, (a > 0) ? rc->cup[j] : rc->clo[j], i, a);
+                nfix++;
+            }
+        }
+    }
+    else {
+        return 0;
+    }
+
+    rc->map->iop[2 * rc->cap + op] = nfix;
+    *changed = 1;
+
+    return 0;
+}
+
+static int redPass(redCtx *rc, int *changed) {
+
+    int i, j, ret = 0;
+
+    *changed = 0;
+
+    for (j = 1; j <= rc->n; j++) {
+        if ( (rc->clive[j]) && (rc->clo[j] == rc->cup[j]) ) {
+            redFix(rc, j, rc->clo[j], 0, 0);
+            *changed = 1;
+        }
+    }
+
+    for (i = 1; (i <= rc->m) && (ret == 0); i++) {
+        if (!rc->rlive[i]) {
+            continue;
+        }
+        if (rc->rcnt[i] == 0) {
+            if ( (rc->rlo[i] > redTol(rc, rc->rlo[i])) ||
+                 (rc->rup[i] < -redTol(rc, rc->rup[i])) ) {
+                ret = GLP_ENOPFS;
+                break;
+            }
+            redPush(rc, GLPK_RED_EMPTY, i, 0, 0, 0, 0, 0);
+            rc->rlive[i] = 0;
+            *changed = 1;
+        }
+        else if (rc->rcnt[i] == 1) {
+            ret = redSingleton(rc, i);
+            *changed = 1;
+        }
+        else {
+            ret = redActivity(rc, i, changed);
+        }
+    }
+
+    return ret;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* reduced problem                                                            */
+/* -------------------------------------------------------------------------- */
+
+static int redType(double lo, double up) {
+
+    if ( (lo == -HUGE_VAL) && (up == HUGE_VAL) ) {
+        return GLP_FR;
+    }
+    if (lo == -HUGE_VAL) {
+        return GLP_UP;
+    }
+    if (up == HUGE_VAL) {
+        return GLP_LO;
+    }
+
+    return (lo == up) ? GLP_FX : GLP_DB;
+}
+
+static double redFinite(double b) {
+    return (fabs(b) == HUGE_VAL) ? 0 : b;
+}
+
+static int redBuild(redCtx *rc, glp_prob *P, glp_prob *Q) {
+
+    glpkReduceMap *mp = rc->map;
+    int *rnew, *ia = NULL, *ja = NULL;
+    double *ar = NULL;
+    int i, j, k, nz = 0;
+
+    rnew = calloc((size_t) rc->m + 1, sizeof(int));
+    if (rnew == NULL) {
+        return -1;
+    }
+
+    glp_set_prob_name(Q, glp_get_prob_name(P));
+    glp_set_obj_name(Q, glp_get_obj_name(P));
+    glp_set_obj_dir(Q, glp_get_obj_dir(P));
+    glp_set_obj_coef(Q, 0, glp_get_obj_coef(P, 0) + rc->c0);
+
+    for (i = 1; i <= rc->m; i++) {
+        if (rc->rlive[i]) {
+            mp->rowmap[mp->nr++] = i;
+            rnew[i] = mp->nr;
+        }
+    }
+    for (j = 1; j <= rc->n; j++) {
+        if (rc->clive[j]) {
+            mp->colmap[mp->nc++] = j;
+            for (k = rc->cbeg[j]; k < rc->cbeg[j+1]; k++) {
+                nz += (rnew[rc->cind[k]] > 0);
+            }
+        }
+    }
+
+    if (mp->nr > 0) {
+        glp_add_rows(Q, mp->nr);
+    }
+    for (k = 0; k < mp->nr; k++) {
+        i = mp->rowmap[k];
+        glp_set_row_name(Q, k + 1, glp_get_row_name(P, i));
+        glp_set_row_bnds(Q, k + 1, redType(rc->rlo[i], rc->rup[i]),
+                         redFinite(rc->rlo[i]), redFinite(rc->rup[i]));
+    }
+
+    if (mp->nc > 0) {
+        glp_add_cols(Q, mp->nc);
+    }
+    for (k = 0; k < mp->nc; k++) {
+        j = mp->colmap[k];
+        glp_set_col_name(Q, k + 1, glp_get_col_name(P, j));
+        /* setting the kind may change the bounds */
+        glp_set_col_kind(Q, k + 1, glp_get_col_kind(P, j));
+        glp_set_col_bnds(Q, k + 1, redType(rc->clo[j], rc->cup[j]),
+                         redFinite(rc->clo[j]), redFinite(rc->cup[j]));
+        glp_set_obj_coef(Q, k + 1, rc->c[j]);
+    }
+
+    if (nz > 0) {
+        ia = malloc(((size_t) nz + 1) * sizeof(int));
+        ja = malloc(((size_t) nz + 1) * sizeof(int));
+        ar = malloc(((size_t) nz + 1) * sizeof(double));
+        if ( (ia == NULL) || (ja == NULL) || (ar == NULL) ) {
+            free(ia);
+            free(ja);
+            free(ar);
+            free(rnew);
+            return -1;
+        }
+        nz = 0;
+        for (k = 0; k < mp->nc; k++) {
+            j = mp->colmap[k];
+            for (i = rc->cbeg[j]; i < rc->cbeg[j+1]; i++) {
+                if (rnew[rc->cind[i]] > 0) {
+                    nz++;
+                    ia[nz] = rnew[rc->cind[i]];
+                    ja[nz] = k + 1;
+                    ar[nz] = rc->cval[i];
+                }
+            }
+        }
+        glp_load_matrix(Q, nz, ia, ja, ar);
+        free(ia);
+        free(ja);
+        free(ar);
+    }
+
+    free(rnew);
+
+    return 0;
+}
+
+/* read P into rc, returns nonzero if out of memory */
+static int redRead(redCtx *rc, glp_prob *P) {
+
+    int m = rc->m, n = rc->n;
+    int i, j, k, len, nnz;
+    int *pos;
+
+    nnz = glp_get_num_nz(P);
+
+    rc->rbeg  = malloc(((size_t) m + 2) * sizeof(int));
+    rc->rind  = malloc(((size_t) nnz + 1) * sizeof(int));
+    rc->rval  = malloc(((size_t) nnz + 1) * sizeof(double));
+    rc->cbeg  = malloc(((size_t) n + 2) * sizeof(int));
+    rc->cind  = malloc(((size_t) nnz + 1) * sizeof(int));
+    rc->cval  = malloc(((size_t) nnz + 1) * sizeof(double));
+    rc->rlo   = malloc(((size_t) m + 1) * sizeof(double));
+    rc->rup   = malloc(((size_t) m + 1) * sizeof(double));
+    rc->clo   = malloc(((size_t) n + 1) * sizeof(double));
+    rc->cup   = malloc(((size_t) n + 1) * sizeof(double));
+    rc->c     = malloc(((size_t) n + 1) * sizeof(double));
+    rc->kind  = malloc(((size_t) n + 1) * sizeof(int));
+    rc->rlive = malloc(((size_t) m + 1) * sizeof(int));
+    rc->clive = malloc(((size_t) n + 1) * sizeof(int));
+    rc->rcnt  = calloc((size_t) m + 2, sizeof(int));
+
+    if ( (rc->rbeg == NULL) || (rc->rind == NULL) || (rc->rval == NULL) ||
+         (rc->cbeg == NULL) || (rc->cind == NULL) || (rc->cval == NULL) ||
+         (rc->rlo == NULL) || (rc->rup == NULL) || (rc->clo == NULL) ||
+         (rc->cup == NULL) || (rc->c == NULL) || (rc->kind == NULL) ||
+         (rc->rlive == NULL) || (rc->clive == NULL) || (rc->rcnt == NULL) ) {
+        return 1;
+    }
+
+    for (i = 1; i <= m; i++) {
+        rc->rlo[i] = -HUGE_VAL;
+        rc->rup[i] = HUGE_VAL;
+        switch (glp_get_row_type(P, i)) {
+            case GLP_LO:
+                rc->rlo[i] = glp_get_row_lb(P, i);
+                break;
+            case GLP_UP:
+                rc->rup[i] = glp_get_row_ub(P, i);
+                break;
+            case GLP_DB:
+            case GLP_FX:
+                rc->rlo[i] = glp_get_row_lb(P, i);
+                rc->rup[i] = glp_get_row_ub(P, i);
+                break;
+        }
+        rc->rlive[i] = 1;
+    }
+
+    rc->cbeg[1] = 1;
+    for (j = 1; j <= n; j++) {
+        rc->clo[j] = -HUGE_VAL;
+        rc->cup[j] = HUGE_VAL;
+        switch (glp_get_col_type(P, j)) {
+            case GLP_LO:
+                rc->clo[j] = glp_get_col_lb(P, j);
+                break;
+            case GLP_UP:
+                rc->cup[j] = glp_get_col_ub(P, j);
+                break;
+            case GLP_DB:
+            case GLP_FX:
+                rc->clo[j] = glp_get_col_lb(P, j);
+                rc->cup[j] = glp_get_col_ub(P, j);
+                break;
+        }
+        rc->c[j]     = glp_get_obj_coef(P, j);
+        rc->kind[j]  = glp_get_col_kind(P, j);
+        rc->clive[j] = 1;
+
+        /* glp_get_mat_col stores from index 1 on */
+        len = glp_get_mat_col(P, j, rc->cind + rc->cbeg[j] - 1,
+                              rc->cval + rc->cbeg[j] - 1);
+        rc->cbeg[j+1] = rc->cbeg[j] + len;
+        for (k = rc->cbeg[j]; k < rc->cbeg[j+1]; k++) {
+            rc->rcnt[rc->cind[k]]++;
+        }
+    }
+
+    /* transpose */
+    rc->rbeg[1] = 1;
+    for (i = 1; i <= m; i++) {
+        rc->rbeg[i+1] = rc->rbeg[i] + rc->rcnt[i];
+    }
+    pos = rc->rcnt;
+    for (i = 1; i <= m; i++) {
+        pos[i] = rc->rbeg[i];
+    }
+    for (j = 1; j <= n; j++) {
+        for (k = rc->cbeg[j]; k < rc->cbeg[j+1]; k++) {
+            i = rc->cind[k];
+            rc->rind[pos[i]] = j;
+            rc->rval[pos[i]] = rc->cval[k];
+            pos[i]++;
+        }
+    }
+    for (i = 1; i <= m; i++) {
+        rc->rcnt[i] = rc->rbeg[i+1] - rc->rbeg[i];
+    }
+
+    return 0;
+}
+
+static void redFree(redCtx *rc) {
+
+    free(rc->rbeg);
+    free(rc->rind);
+    free(rc->rval);
+    free(rc->cbeg);
+    free(rc->cind);
+    free(rc->cval);
+    free(rc->rlo);
+    free(rc->rup);
+    free(rc->clo);
+    free(rc->cup);
+    free(rc->c);
+    free(rc->kind);
+    free(rc->rlive);
+    free(rc->clive);
+    free(rc->rcnt);
+}
+
+int glpkReduce(glp_prob *P, glp_prob *Q, double tol, glpkReduceMap *map) {
+
+    redCtx rc;
+    int t, changed, ret = 0;
+
+    memset(&rc, 0, sizeof(rc));
+    memset(map, 0, sizeof(glpkReduceMap));
+
+    rc.m   = map->m = glp_get_num_rows(P);
+    rc.n   = map->n = glp_get_num_cols(P);
+    rc.cap = rc.m + rc.n + 1;
+    rc.tol = tol;
+    rc.map = map;
+
+    map->rowmap = malloc(((size_t) rc.m + 1) * sizeof(int));
+    map->colmap = malloc(((size_t) rc.n + 1) * sizeof(int));
+    map->iop    = malloc(4 * (size_t) rc.cap * sizeof(int));
+    map->dop    = malloc(3 * (size_t) rc.cap * sizeof(double));
+
+    if ( (map->rowmap == NULL) || (map->colmap == NULL) ||
+         (map->iop == NULL) || (map->dop == NULL) || redRead(&rc, P) ) {
+        redFree(&rc);
+        glpkReduceFree(map);
+        return -1;
+    }
+
+    /* every pass removes something, each row and column goes once */
+    do {
+        ret = redPass(&rc, &changed);
+    } while ( (ret == 0) && (changed) );
+
+    if (ret == 0) {
+        ret = redBuild(&rc, P, Q);
+    }
+
+    /* close the gaps between the columns of iop and dop */
+    for (t = 1; t < 4; t++) {
+        memmove(map->iop + t * map->nop, map->iop + t * rc.cap,
+                (size_t) map->nop * sizeof(int));
+    }
+    for (t = 1; t < 3; t++) {
+        memmove(map->dop + t * map->nop, map->dop + t * rc.cap,
+                (size_t) map->nop * sizeof(double));
+    }
+
+    redFree(&rc);
+
+    if (ret < 0) {
+        glpkReduceFree(map);
+    }
+
+    return ret;
+}
+
+void glpkReduceFree(glpkReduceMap *map) {
+
+    free(map->rowmap);
+    free(map->colmap);
+    free(map->iop);
+    free(map->dop);
+
+    map->rowmap = NULL;
+    map->colmap = NULL;
+    map->iop    = NULL;
+    map->dop    = NULL;
+    map->nop    = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* postsolve                                                                  */
+/* -------------------------------------------------------------------------- */
+
+int glpkReduceCheck(const glpkReduceMap *map) {
+
+    const int *type = map->iop;
+    const int *row  = map->iop + map->nop;
+    const int *col  = map->iop + 2 * map->nop;
+    const double *a = map->dop;
+    int k, q;
+
+    for (k = 0; k < map->nr; k++) {
+        if ( (map->rowmap[k] < 1) || (map->rowmap[k] > map->m) ) {
+            return 1;
+        }
+    }
+    for (k = 0; k < map->nc; k++) {
+        if ( (map->colmap[k] < 1) || (map->colmap[k] > map->n) ) {
+            return 1;
+        }
+    }
+    for (k = 0; k < map->nop; k++) {
+        if ( (row[k] < 0) || (row[k] > map->m) ) {
+            return 1;
+        }
+        switch (type[k]) {
+            case GLPK_RED_FIXCOL:
+            case GLPK_RED_SINGLETON:
+                if ( (col[k] < 1) || (col[k] > map->n) ) {
+                    return 1;
+                }
+                break;
+            case GLPK_RED_FORCING:
+                if ( (col[k] < 0) || (col[k] >= map->nop - k) ) {
+                    return 1;
+                }
+                /* followed by the columns fixed by the row */
+                for (q = k + 1; q <= k + col[k]; q++) {
+                    if ( (type[q] != GLPK_RED_FIXCOL) || (row[q] != row[k]) ||
+                         (col[q] < 1) || (col[q] > map->n) || (a[q] == 0) ) {
+                        return 1;
+                    }
+                }
+                break;
+            case GLPK_RED_EMPTY:
+            case GLPK_RED_REDUNDANT:
+                break;
+            default:
+                return 1;
+        }
+        if ( (type[k] != GLPK_RED_FIXCOL) && (row[k] == 0) ) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* reduced cost of column j over the rows restored so far */
+static double postDual(glp_prob *P, int j, const double *rdual,
+                       const int *present, int *ind, double *val) {
+
+    int k, len;
+    double d = glp_get_obj_coef(P, j);
+
+    len = glp_get_mat_col(P, j, ind, val);
+    for (k = 1; k <= len; k++) {
+        if (present[ind[k]]) {
+            d -= val[k] * rdual[ind[k]-1];
+        }
+    }
+
+    return d;
+}
+
+static int postAt(double x, double b) {
+    return (fabs(x - b) <= REDUCE_EPS * (1.0 + fabs(b)));
+}
+
+int glpkPostsolve(glp_prob *P, glp_prob *Q, const glpkReduceMap *map,
+                  double *cprim, double *cdual, double *rprim,
+                  double *rdual) {
+
+    const int *type = map->iop;
+    const int *row  = map->iop + map->nop;
+    const int *col  = map->iop + 2 * map->nop;
+    const int *flag = map->iop + 3 * map->nop;
+    const double *a  = map->dop;
+    const double *lo = map->dop + map->nop;
+    const double *up = map->dop + 2 * map->nop;
+    int *present, *ind;
+    double *val;
+    double sgn, d, r, y;
+    int i, j, k, q, len;
+
+    present = calloc((size_t) map->m + 1, sizeof(int));
+    ind     = malloc(((size_t) map->m + 1) * sizeof(int));
+    val     = malloc(((size_t) map->m + 1) * sizeof(double));
+    if ( (present == NULL) || (ind == NULL) || (val == NULL) ) {
+        free(present);
+        free(ind);
+        free(val);
+        return 1;
+    }
+
+    /* sign of the reduced cost of a column at its lower bound */
+    sgn = (glp_get_obj_dir(P) == GLP_MIN) ? 1.0 : -1.0;
+
+    for (j = 0; j < map->n; j++) {
+        cprim[j] = 0;
+    }
+    for (i = 0; i < map->m; i++) {
+        rdual[i] = 0;
+    }
+    for (k = 0; k < map->nc; k++) {
+        cprim[map->colmap[k]-1] = glp_get_col_prim(Q, k + 1);
+    }
+    for (k = 0; k < map->nr; k++) {
+        rdual[map->rowmap[k]-1] = glp_get_row_dual(Q, k + 1);
+        present[map->rowmap[k]] = 1;
+    }
+    for (k = 0; k < map->nop; k++) {
+        if (type[k] == GLPK_RED_FIXCOL) {
+            cprim[col[k]-1] = lo[k];
+        }
+    }
+
+    /* row duals in reverse order */
+    for (k = map->nop - 1; k >= 0; k--) {
+        i = row[k];
+        y = 0;
+        switch (type[k]) {
+            case GLPK_RED_FIXCOL:
+                continue;
+            case GLPK_RED_SINGLETON:
+                /* the dual of an active bound from row i moves to row i */
+                j = col[k];
+                d = postDual(P, j, rdual, present, ind, val);
+                if ( (flag[k] & 1) && (sgn * d > 0) &&
+                     postAt(cprim[j-1], lo[k]) ) {
+                    y = d / a[k];
+                }
+                else if ( (flag[k] & 2) && (sgn * d < 0) &&
+                          postAt(cprim[j-1], up[k]) ) {
+                    y = d / a[k];
+                }
+                break;
+            case GLPK_RED_FORCING:
+                /* smallest row dual making all fixed columns dual
+                   feasible */
+                for (q = k + 1; q <= k + col[k]; q++) {
+                    d = postDual(P, col[q], rdual, present, ind, val);
+                    r = d / a[q];
+                    if ( (flag[k] == 2) ? (sgn * r < sgn * y)
+                                        : (sgn * r > sgn * y) ) {
+                        y = r;
+                    }
+                }
+                break;
+        }
+        rdual[i-1] = y;
+        present[i] = 1;
+    }
+
+    /* row activities and reduced costs from the original matrix */
+    for (i = 0; i < map->m; i++) {
+        rprim[i] = 0;
+    }
+    for (j = 1; j <= map->n; j++) {
+        d = glp_get_obj_coef(P, j);
+        len = glp_get_mat_col(P, j, ind, val);
+        for (k = 1; k <= len; k++) {
+            rprim[ind[k]-1] += val[k] * cprim[j-1];
+            d -= val[k] * rdual[ind[k]-1];
+        }
+        cdual[j-1] = d;
+    }
+
+    free(present);
+    free(ind);
+    free(val);
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/* glpkReduce.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* persistent structural reduction                                            */
+/* -------------------------------------------------------------------------- */
+
+/* The reductions are applied until none applies any more:
+   - fixed columns are removed, their activity moves into the row bounds
+     and the objective constant,
+   - empty rows are removed,
+   - singleton rows become bounds of their column,
+   - rows which can not be active are removed (redundant rows),
+   - rows which can only be satisfied with all their columns at one bound
+     fix these columns and are removed (forcing rows).
+   Every reduction is recorded. Postsolve recovers the column values of
+   removed columns, then the row duals of removed rows in reverse order
+   (as the presolver of GLPK does), and finally row activities and reduced
+   costs from the original matrix. */
+
+/* reductions */
+#define GLPK_RED_FIXCOL    1  /* column fixed at lo */
+#define GLPK_RED_EMPTY     2  /* empty row */
+#define GLPK_RED_SINGLETON 3  /* row with coefficient a in column col gave
+                                 bounds lo (flag 1) and up (flag 2) */
+#define GLPK_RED_REDUNDANT 4  /* row never active */
+#define GLPK_RED_FORCING   5  /* row at its upper (flag 2) or lower (flag 1)
+                                 bound; it fixed the col columns of the next
+                                 col reductions */
+
+typedef struct {
+    int m;                   /* original numbers of rows and columns */
+    int n;
+    int nr;                  /* reduced numbers of rows and columns */
+    int nc;
+    int *rowmap;             /* original index of every reduced row */
+    int *colmap;             /* original index of every reduced column */
+    int nop;                 /* reductions, in order */
+    int *iop;                /* nop x 4, column major: type, row, col, flag */
+    double *dop;             /* nop x 3, column major: a, lo, up */
+} glpkReduceMap;
+
+/* Reduce P into the empty problem Q (names, kinds and objective are
+   copied) with tolerance tol. Returns 0, GLP_ENOPFS if P was found
+   infeasible (Q is empty then), -1 if out of memory. */
+int glpkReduce(glp_prob *P, glp_prob *Q, double tol, glpkReduceMap *map);
+
+void glpkReduceFree(glpkReduceMap *map);
+
+/* nonzero if the indices in map are out of range */
+int glpkReduceCheck(const glpkReduceMap *map);
+
+/* Map the basic solution of Q back to P (which must be unchanged since the
+   reduction): column primal values and reduced costs (n elements), row
+   activities and duals (m elements). Returns nonzero if out of memory. */
+int glpkPostsolve(glp_prob *P, glp_prob *Q, const glpkReduceMap *map,
+                  double *cprim, double *cdual, double *rprim,
+                  double *rdual);
@@ -0,0 +1,495 @@
+/* glpkSample.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkProf.h"
+#include "glpkTeam.h"
+#include "glpkSample.h"
+
+/* components of a direction below are taken as zero */
+#define SAMPLE_DIR_TOL 1e-10
+
+
+/* -------------------------------------------------------------------------- */
+/* polytope                                                                   */
+/* -------------------------------------------------------------------------- */
+
+static void sampleBounds(int type, double lb, double ub, double *l, double *u) {
+
+    *l = ( (type == GLP_LO) || (type == GLP_DB) || (type == GLP_FX) )
+         ? lb : -HUGE_VAL;
+    *u = ( (type == GLP_UP) || (type == GLP_DB) || (type == GLP_FX) )
+         ? ub : HUGE_VAL;
+}
+
+/* row activities y = A x */
+static void sampleAx(const glpkSample *sp, const double *x, double *y) {
+
+    int i, t;
+    double s;
+
+    for (i = 0; i < sp->m; i++) {
+        s = 0;
+        for (t = sp->rp[i]; t < sp->rp[i+1]; t++) {
+            s += sp->v[t] * x[sp->ci[t]];
+        }
+        y[i] = s;
+    }
+}
+
+/* one sweep of row projections (Kaczmarz) onto the equality rows, y = A x
+   is recomputed */
+static void sampleProject(const glpkSample *sp, double *x, double *y) {
+
+    int i, t;
+    double r;
+
+    for (i = 0; i < sp->m; i++) {
+        if (sp->enrm[i] == 0) {
+            continue;
+        }
+        r = -sp->rlb[i];
+        for (t = sp->rp[i]; t < sp->rp[i+1]; t++) {
+            r += sp->v[t] * x[sp->ci[t]];
+        }
+        r /= sp->enrm[i];
+        for (t = sp->rp[i]; t < sp->rp[i+1]; t++) {
+            x[sp->ci[t]] -= r * sp->v[t];
+        }
+    }
+
+    sampleAx(sp, x, y);
+}
+
+void glpkSampleFree(glpkSample *sp) {
+
+    free(sp->rp);
+    free(sp->ci);
+    free(sp->v);
+    free(sp->rlb);
+    free(sp->rub);
+    free(sp->clb);
+    free(sp->cub);
+    free(sp->enrm);
+    free(sp->aw);
+    sp->rp   = NULL;
+    sp->ci   = NULL;
+    sp->v    = NULL;
+    sp->rlb  = NULL;
+    sp->rub  = NULL;
+    sp->clb  = NULL;
+    sp->cub  = NULL;
+    sp->enrm = NULL;
+    sp->aw   = NULL;
+}
+
+int glpkSampleInit(glpkSample *sp, glp_prob *P, int nwarm,
+                   const double *warm) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int nnz = glp_get_num_nz(P);
+    int *rind;
+    double *rval;
+    int i, j, k, t, len;
+
+    sp->m     = m;
+    sp->n     = n;
+    sp->nwarm = nwarm;
+    sp->warm  = warm;
+
+    sp->rp   = malloc(((size_t) m + 1) * sizeof(int));
+    sp->ci   = malloc(((size_t) nnz + 1) * sizeof(int));
+    sp->v    = malloc(((size_t) nnz + 1) * sizeof(double));
+    sp->rlb  = malloc(((size_t) m + 1) * sizeof(double));
+    sp->rub  = malloc(((size_t) m + 1) * sizeof(double));
+    sp->clb  = malloc(((size_t) n + 1) * sizeof(double));
+    sp->cub  = malloc(((size_t) n + 1) * sizeof(double));
+    sp->enrm = malloc(((size_t) m + 1) * sizeof(double));
+    sp->aw   = malloc(((size_t) m * nwarm + 1) * sizeof(double));
+    rind     = malloc(((size_t) n + 1) * sizeof(int));
+    rval     = malloc(((size_t) n + 1) * sizeof(double));
+
+    if ( (sp->rp == NULL) || (sp->ci == NULL) || (sp->v == NULL) ||
+         (sp->rlb == NULL) || (sp->rub == NULL) || (sp->clb == NULL) ||
+         (sp->cub == NULL) || (sp->enrm == NULL) || (sp->aw == NULL) ||
+         (rind == NULL) ||
+         (rval == NULL) ) {
+        glpkSampleFree(sp);
+        free(rind);
+        free(rval);
+        return 1;
+    }
+
+    sp->rp[0] = 0;
+    for (i = 1; i <= m; i++) {
+        len = glp_get_mat_row(P, i, rind, rval);
+        for (t = 1; t <= len; t++) {
+            sp->ci[sp->rp[i-1] + t - 1] = rind[t] - 1;
+            sp->v[sp->rp[i-1] + t - 1]  = rval[t];
+        }
+        sp->rp[i] = sp->rp[i-1] + len;
+        sampleBounds(glp_get_row_type(P, i), glp_get_row_lb(P, i),
+                     glp_get_row_ub(P, i), &sp->rlb[i-1], &sp->rub[i-1]);
+        sp->enrm[i-1] = 0;
+        if (glp_get_row_type(P, i) == GLP_FX) {
+            for (t = 1; t <= len; t++) {
+                sp->enrm[i-1] += rval[t] * rval[t];
+            }
+        }
+    }
+    for (j = 1; j <= n; j++) {
+        sampleBounds(glp_get_col_type(P, j), glp_get_col_lb(P, j),
+                     glp_get_col_ub(P, j), &sp->clb[j-1], &sp->cub[j-1]);
+    }
+
+    for (k = 0; k < nwarm; k++) {
+        sampleAx(sp, warm + (size_t) k * n, sp->aw + (size_t) k * m);
+    }
+
+    free(rind);
+    free(rval);
+
+    return 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* chains                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    const glpkSample *sp;
+    int npoints;
+    int thin;
+    int nchains;
+    unsigned int seed;
+    double *out;
+    FILE *fp;
+    int next;                /* next chain to run */
+    int done;                /* points generated */
+    int oom;
+    int intr;                /* interrupted, without workers */
+    double tpoll;            /* time of the last poll, without workers */
+} sampleData;
+
+/* uniform on (0, 1), splitmix64 */
+static double sampleUnif(uint64_t *s) {
+
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+
+    return ((double) (z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static void sampleLock(glpkTeam *tm) {
+    if (tm != NULL) {
+        glpkTeamLock(tm);
+    }
+}
+
+static void sampleUnlock(glpkTeam *tm) {
+    if (tm != NULL) {
+        glpkTeamUnlock(tm);
+    }
+}
+
+static void checkInterrupt(void *dummy) {
+    R_CheckUserInterrupt();
+}
+
+/* nonzero if the chains have to stop */
+static int sampleStop(sampleData *sd, glpkTeam *tm) {
+
+    double now;
+
+    if (tm != NULL) {
+        return glpkTeamCancelled(tm);
+    }
+
+    now = glpkProfTime();
+    if ( (glpkSolveInterrupt) && (now - sd->tpoll >= GLPK_POLL_INTERVAL) ) {
+        sd->tpoll = now;
+        if (R_ToplevelExec(checkInterrupt, NULL) == FALSE) {
+            sd->intr = 1;
+        }
+    }
+
+    return sd->intr;
+}
+
+/* min and max of t with lb <= x + t d <= ub */
+static void sampleRange(int n, const double *x, const double *d,
+                        const double *lb, const double *ub, int skipfx,
+                        double *tmin, double *tmax) {
+
+    double lo, hi, s;
+    int j;
+
+    for (j = 0; j < n; j++) {
+        if ( (fabs(d[j]) <= SAMPLE_DIR_TOL) ||
+             ( (skipfx) && (lb[j] == ub[j]) ) ) {
+            continue;
+        }
+        lo = (lb[j] - x[j]) / d[j];
+        hi = (ub[j] - x[j]) / d[j];
+        if (d[j] < 0) {
+            s = lo; lo = hi; hi = s;
+        }
+        if (lo > *tmin) {
+            *tmin = lo;
+        }
+        if (hi < *tmax) {
+            *tmax = hi;
+        }
+    }
+}
+
+static void sampleStep(const glpkSample *sp, uint64_t *rng, double *x,
+                       double *ax, double *ctr, double *ac, double *d,
+                       double *ad, double *cnt) {
+
+    const double *w, *aw;
+    double nrm = 0, tmin = -HUGE_VAL, tmax = HUGE_VAL, t;
+    int i, j, k;
+
+    k = (int) (sampleUnif(rng) * sp->nwarm);
+    if (k >= sp->nwarm) {
+        k = sp->nwarm - 1;
+    }
+    w  = sp->warm + (size_t) k * sp->n;
+    aw = sp->aw + (size_t) k * sp->m;
+
+    for (j = 0; j < sp->n; j++) {
+        d[j] = w[j] - ctr[j];
+        nrm += d[j] * d[j];
+    }
+    nrm = sqrt(nrm);
+    if (nrm <= SAMPLE_DIR_TOL) {
+        return;
+    }
+    for (j = 0; j < sp->n; j++) {
+        d[j] /= nrm;
+    }
+    for (i = 0; i < sp->m; i++) {
+        ad[i] = (aw[i] - ac[i]) / nrm;
+    }
+
+    /* direction stays in equality rows, they are not checked */
+    sampleRange(sp->n, x, d, sp->clb, sp->cub, 0, &tmin, &tmax);
+    sampleRange(sp->m, ax, ad, sp->rlb, sp->rub, 1, &tmin, &tmax);
+    if ( (!R_FINITE(tmin)) || (!R_FINITE(tmax)) || (tmin > tmax) ) {
+        return;
+    }
+
+    t = tmin + sampleUnif(rng) * (tmax - tmin);
+
+    *cnt += 1;
+    for (j = 0; j < sp->n; j++) {
+        x[j]   += t * d[j];
+        ctr[j] += (x[j] - ctr[j]) / *cnt;
+    }
+    for (i = 0; i < sp->m; i++) {
+        ax[i] += t * ad[i];
+        ac[i] += (ax[i] - ac[i]) / *cnt;
+    }
+}
+
+static void sampleStore(sampleData *sd, glpkTeam *tm, int p,
+                        const double *x) {
+
+    int j, n = sd->sp->n;
+
+    if (sd->out != NULL) {
+        for (j = 0; j < n; j++) {
+            sd->out[(size_t) p * n + j] = x[j];
+        }
+        sampleLock(tm);
+        sd->done++;
+        sampleUnlock(tm);
+    }
+    else {
+        sampleLock(tm);
+        for (j = 0; j < n; j++) {
+            fprintf(sd->fp, (j < n - 1) ? "%.17g\t" : "%.17g\n", x[j]);
+        }
+        sd->done++;
+        sampleUnlock(tm);
+    }
+}
+
+/* returns 0, 1 if out of memory, 2 if stopped */
+static int sampleChain(sampleData *sd, int c, glpkTeam *tm) {
+
+    const glpkSample *sp = sd->sp;
+    double *x, *ctr, *d, *ax, *ac, *ad;
+    double cnt = sp->nwarm;
+    uint64_t rng;
+    int i, j, k, p, s, ret = 0;
+    int p0 = (int) ((long) c * sd->npoints / sd->nchains);
+    int p1 = (int) ((long) (c + 1) * sd->npoints / sd->nchains);
+
+    x   = malloc(((size_t) sp->n + 1) * sizeof(double));
+    ctr = malloc(((size_t) sp->n + 1) * sizeof(double));
+    d   = malloc(((size_t) sp->n + 1) * sizeof(double));
+    ax  = malloc(((size_t) sp->m + 1) * sizeof(double));
+    ac  = malloc(((size_t) sp->m + 1) * sizeof(double));
+    ad  = malloc(((size_t) sp->m + 1) * sizeof(double));
+
+    if ( (x == NULL) || (ctr == NULL) || (d == NULL) || (ax == NULL) ||
+         (ac == NULL) || (ad == NULL) ) {
+        ret = 1;
+        goto done;
+    }
+
+    /* every chain starts at the center of the warm-up points */
+    for (j = 0; j < sp->n; j++) {
+        ctr[j] = 0;
+        for (k = 0; k < sp->nwarm; k++) {
+            ctr[j] += sp->warm[(size_t) k * sp->n + j];
+        }
+        ctr[j] /= sp->nwarm;
+        x[j] = ctr[j];
+    }
+    sampleAx(sp, ctr, ac);
+    for (i = 0; i < sp->m; i++) {
+        ax[i] = ac[i];
+    }
+
+    rng = (uint64_t) sd->seed * 0x100000001B3ULL + (uint64_t) c;
+    sampleUnif(&rng);
+
+    for (p = p0; p < p1; p++) {
+        for (s = 0; s < sd->thin; s++) {
+            sampleStep(sp, &rng, x, ax, ctr, ac, d, ad, &cnt);
+        }
+        sampleProject(sp, x, ax);
+        sampleProject(sp, ctr, ac);
+        sampleStore(sd, tm, p, x);
+        if (sampleStop(sd, tm)) {
+            ret = 2;
+            break;
+        }
+    }
+
+    done:
+    free(x);
+    free(ctr);
+    free(d);
+    free(ax);
+    free(ac);
+    free(ad);
+
+    return ret;
+}
+
+static void sampleWorker(glpkTeam *tm, int w, void *data) {
+
+    sampleData *sd = data;
+    int c, ret;
+
+    for (;;) {
+        glpkTeamLock(tm);
+        c = sd->next++;
+        glpkTeamUnlock(tm);
+        if (c >= sd->nchains) {
+            break;
+        }
+        ret = sampleChain(sd, c, tm);
+        if (ret != 0) {
+            if (ret == 1) {
+                glpkTeamLock(tm);
+                sd->oom = 1;
+                glpkTeamUnlock(tm);
+            }
+            glpkTeamCancel(tm);
+            break;
+        }
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* driver                                                                     */
+/* -------------------------------------------------------------------------- */
+
+int glpkSampleRun(const glpkSample *sp, int npoints, int thin, int nchains,
+                  int nthreads, unsigned int seed, double *out, FILE *fp,
+                  int *intr) {
+
+    sampleData sd;
+    size_t e, ne = (size_t) sp->n * (size_t) npoints;
+    int c, ret, nw;
+
+    *intr = 0;
+
+    if (out != NULL) {
+        for (e = 0; e < ne; e++) {
+            out[e] = R_NaN;
+        }
+    }
+    if ( (npoints < 1) || (sp->nwarm < 1) ) {
+        return 0;
+    }
+
+    sd.sp      = sp;
+    sd.npoints = npoints;
+    sd.thin    = (thin < 1) ? 1 : thin;
+    sd.nchains = (nchains < 1) ? 1 : ( (nchains > npoints) ? npoints
+                                                           : nchains );
+    sd.seed    = seed;
+    sd.out     = out;
+    sd.fp      = fp;
+    sd.next    = 0;
+    sd.done    = 0;
+    sd.oom     = 0;
+    sd.intr    = 0;
+    sd.tpoll   = glpkProfTime();
+
+    nw = (nthreads < sd.nchains) ? nthreads : sd.nchains;
+
+    if ( (nw < 2) || (glpkTeamRun(nw, 0, sampleWorker, &sd, intr) == 0) ) {
+        for (c = 0; c < sd.nchains; c++) {
+            ret = sampleChain(&sd, c, NULL);
+            if (ret == 1) {
+                sd.oom = 1;
+            }
+            if (ret != 0) {
+                break;
+            }
+        }
+        *intr = sd.intr;
+    }
+
+    return (sd.oom) ? -1 : sd.done;
+}
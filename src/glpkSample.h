@@ -0,0 +1,73 @@
+/* glpkSample.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* artificial centering hit-and-run sampler                                   */
+/* -------------------------------------------------------------------------- */
+
+/* The polytope is given by the constraint matrix and the bounds of rows and
+   columns of a problem, copied once by glpkSampleInit; the chains never
+   call GLPK and run in worker threads (see glpkTeam.h) without needing a
+   thread safe GLPK. Warm-up points (feasible points, e.g. LP solutions) span
+   the directions: every step moves along the difference of a random
+   warm-up point and the center of all points so far, by a uniform random
+   step within the polytope (Kaufman and Smith 1998). Row activities are
+   updated along with the point: with A w precomputed for the warm-up points
+   and A c kept for the center, a step costs O(m + n) instead of a matrix
+   vector product. Directions keep the equality rows only up to rounding,
+   and the error grows along the chain, so stored points and the center
+   are projected back onto them. */
+
+typedef struct {
+    int m;
+    int n;
+    int *rp;                 /* rows of A: entries rp[i] .. rp[i+1] - 1 */
+    int *ci;                 /* 0-based columns */
+    double *v;
+    double *rlb;             /* row bounds, +-HUGE_VAL if none */
+    double *rub;
+    double *clb;             /* column bounds */
+    double *cub;
+    double *enrm;            /* squared norms of equality rows, 0 for the
+                                other rows */
+    int nwarm;
+    const double *warm;      /* n x nwarm warm-up points, column major */
+    double *aw;              /* m x nwarm row activities of the warm-up
+                                points */
+} glpkSample;
+
+/* copy matrix and bounds of P, returns nonzero if out of memory */
+int glpkSampleInit(glpkSample *sp, glp_prob *P, int nwarm,
+                   const double *warm);
+void glpkSampleFree(glpkSample *sp);
+
+/* Generate npoints points, storing every thin-th point of a chain, with
+   nchains chains (in threads if nthreads > 1). Points are written to out
+   (n x npoints, column major), or to fp as lines of tab separated values if
+   out is NULL. *intr is set after a user interrupt. Returns the number of
+   points generated, -1 if out of memory. */
+int glpkSampleRun(const glpkSample *sp, int npoints, int thin, int nchains,
+                  int nthreads, unsigned int seed, double *out, FILE *fp,
+                  int *intr);
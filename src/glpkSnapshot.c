@@ -0,0 +1,514 @@
+/* glpkSnapshot.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glpkSnapshot.h"
+
+
+/* layout (native byte order, checked via the byte order mark):
+     char[8]  magic "GLPKSNAP"
+     int32    byte order mark 0x01020304
+     int32    format version
+     int32    m, n, nnz, optimization direction
+     double   constant term of the objective
+     string   problem name, objective name
+     m times  int32 type, double lb, double ub, string name
+     n times  int32 type, int32 kind, double lb, double ub, double coef,
+              int32 len, len times (int32 row, double val), string name
+   a string is an int32 length (-1 for no name) followed by the characters */
+
+static const char snapMagic[8] = { 'G', 'L', 'P', 'K', 'S', 'N', 'A', 'P' };
+#define SNAP_BOM 0x01020304
+
+/* limits of GLPK: numbers of rows and columns, length of names */
+#define SNAP_MAXDIM  100000000
+#define SNAP_MAXNAME 255
+
+/* least number of bytes of a row, a column and a nonzero */
+#define SNAP_ROWLEN (2 * sizeof(int) + 2 * sizeof(double))
+#define SNAP_COLLEN (4 * sizeof(int) + 3 * sizeof(double))
+#define SNAP_NZLEN  (sizeof(int) + sizeof(double))
+
+
+/* -------------------------------------------------------------------------- */
+/* buffer                                                                     */
+/* -------------------------------------------------------------------------- */
+
+void glpkBufFree(glpkBuf *buf) {
+    free(buf->data);
+    buf->data = NULL;
+    buf->len  = 0;
+    buf->cap  = 0;
+}
+
+int glpkBufPut(glpkBuf *buf, const void *src, size_t n) {
+
+    unsigned char *ndata;
+    size_t ncap;
+
+    if (buf->len + n > buf->cap) {
+        ncap = (buf->cap == 0) ? 4096 : buf->cap;
+        while (ncap < buf->len + n) {
+            ncap *= 2;
+        }
+        ndata = realloc(buf->data, ncap);
+        if (ndata == NULL) {
+            return 1;
+        }
+        buf->data = ndata;
+        buf->cap  = ncap;
+    }
+    memcpy(buf->data + buf->len, src, n);
+    buf->len += n;
+
+    return 0;
+}
+
+static int bufPutInt(glpkBuf *buf, int val) {
+    return glpkBufPut(buf, &val, sizeof(int));
+}
+
+static int bufPutDbl(glpkBuf *buf, double val) {
+    return glpkBufPut(buf, &val, sizeof(double));
+}
+
+static int bufPutStr(glpkBuf *buf, const char *str) {
+    int len = (str == NULL) ? -1 : (int) strlen(str);
+    if (bufPutInt(buf, len)) {
+        return 1;
+    }
+    return (len > 0) ? glpkBufPut(buf, str, (size_t) len) : 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* reader                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    const unsigned char *data;
+    size_t len;
+    size_t pos;
+} snapReader;
+
+static int rdGet(snapReader *rd, void *dest, size_t n) {
+    if (rd->pos + n > rd->len) {
+        return 1;
+    }
+    memcpy(dest, rd->data + rd->pos, n);
+    rd->pos += n;
+    return 0;
+}
+
+static int rdInt(snapReader *rd, int *val) {
+    return rdGet(rd, val, sizeof(int));
+}
+
+static int rdDbl(snapReader *rd, double *val) {
+    return rdGet(rd, val, sizeof(double));
+}
+
+/* read a string, *str is NULL for no name, free it with free(); a name too
+   long or with control characters is damaged */
+static int rdStr(snapReader *rd, char **str) {
+
+    const unsigned char *c;
+    int len, k;
+
+    *str = NULL;
+    if (rdInt(rd, &len)) {
+        return 1;
+    }
+    if (len < 0) {
+        return 0;
+    }
+    if ( (len > SNAP_MAXNAME) || (rd->pos + (size_t) len > rd->len) ) {
+        return 1;
+    }
+    /* GLPK raises an error for control characters in names */
+    c = rd->data + rd->pos;
+    for (k = 0; k < len; k++) {
+        if ( (c[k] < 0x20) || (c[k] == 0x7f) ) {
+            return 1;
+        }
+    }
+    *str = malloc((size_t) len + 1);
+    if (*str == NULL) {
+        return 1;
+    }
+    memcpy(*str, rd->data + rd->pos, (size_t) len);
+    (*str)[len] = '\0';
+    rd->pos += (size_t) len;
+
+    return 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* snapshot                                                                   */
+/* -------------------------------------------------------------------------- */
+
+int glpkSnapWrite(glp_prob *P, glpkBuf *buf) {
+
+    int m   = glp_get_num_rows(P);
+    int n   = glp_get_num_cols(P);
+    int nnz = glp_get_num_nz(P);
+    int *ind = NULL;
+    double *val = NULL;
+    int i, j, k, len;
+    int err = 0;
+
+    buf->len = 0;
+
+    err |= glpkBufPut(buf, snapMagic, sizeof(snapMagic));
+    err |= bufPutInt(buf, SNAP_BOM);
+    err |= bufPutInt(buf, GLPK_SNAP_VERSION);
+    err |= bufPutInt(buf, m);
+    err |= bufPutInt(buf, n);
+    err |= bufPutInt(buf, nnz);
+    err |= bufPutInt(buf, glp_get_obj_dir(P));
+    err |= bufPutDbl(buf, glp_get_obj_coef(P, 0));
+    err |= bufPutStr(buf, glp_get_prob_name(P));
+    err |= bufPutStr(buf, glp_get_obj_name(P));
+
+    for (i = 1; i <= m && !err; i++) {
+        err |= bufPutInt(buf, glp_get_row_type(P, i));
+        err |= bufPutDbl(buf, glp_get_row_lb(P, i));
+        err |= bufPutDbl(buf, glp_get_row_ub(P, i));
+        err |= bufPutStr(buf, glp_get_row_name(P, i));
+    }
+
+    if (!err) {
+        ind = malloc(((size_t) m + 1) * sizeof(int));
+        val = malloc(((size_t) m + 1) * sizeof(double));
+        err = ( (ind == NULL) || (val == NULL) );
+    }
+
+    for (j = 1; j <= n && !err; j++) {
+        err |= bufPutInt(buf, glp_get_col_type(P, j));
+        err |= bufPutInt(buf, glp_get_col_kind(P, j));
+        err |= bufPutDbl(buf, glp_get_col_lb(P, j));
+        err |= bufPutDbl(buf, glp_get_col_ub(P, j));
+        err |= bufPutDbl(buf, glp_get_obj_coef(P, j));
+        len = glp_get_mat_col(P, j, ind, val);
+        err |= bufPutInt(buf, len);
+        for (k = 1; k <= len; k++) {
+            err |= bufPutInt(buf, ind[k]);
+            err |= bufPutDbl(buf, val[k]);
+        }
+        err |= bufPutStr(buf, glp_get_col_name(P, j));
+    }
+
+    free(ind);
+    free(val);
+
+    return err;
+}
+
+
+int glpkSnapRead(glp_prob *P, const unsigned char *data, size_t len) {
+
+    snapReader rd;
+    char magic[8];
+    char *str = NULL;
+    int bom, ver, m, n, nnz, dir;
+    int type, kind, clen, i, j, k;
+    int *ind = NULL;
+    int *mark = NULL;
+    double *val = NULL;
+    double lb, ub, coef, rest, nz = 0;
+
+    rd.data = data;
+    rd.len  = len;
+    rd.pos  = 0;
+
+    if ( rdGet(&rd, magic, sizeof(magic)) ||
+         (memcmp(magic, snapMagic, sizeof(magic)) != 0) ) {
+        return 1;
+    }
+    if ( rdInt(&rd, &bom) || (bom != SNAP_BOM) ||
+         rdInt(&rd, &ver) || (ver != GLPK_SNAP_VERSION) ) {
+        return 1;
+    }
+    if ( rdInt(&rd, &m) || rdInt(&rd, &n) || rdInt(&rd, &nnz) ||
+         rdInt(&rd, &dir) || rdDbl(&rd, &coef) ||
+         (m < 0) || (n < 0) || (nnz < 0) ||
+         (m > SNAP_MAXDIM) || (n > SNAP_MAXDIM) ) {
+        return 1;
+    }
+
+    /* the sizes must fit into the rest of the data (the two names take at
+       least one int each), before GLPK allocates anything */
+    rest = (double) (rd.len - rd.pos);
+    if ( ((double) nnz > (double) m * (double) n) ||
+         (rest < 2.0 * sizeof(int) + (double) m * SNAP_ROWLEN +
+                 (double) n * SNAP_COLLEN + (double) nnz * SNAP_NZLEN) ) {
+        return 1;
+    }
+
+    glp_erase_prob(P);
+    glp_set_obj_dir(P, (dir == GLP_MAX) ? GLP_MAX : GLP_MIN);
+    glp_set_obj_coef(P, 0, coef);
+
+    if (rdStr(&rd, &str)) {
+        goto fail;
+    }
+    glp_set_prob_name(P, str);
+    free(str);
+    if (rdStr(&rd, &str)) {
+        goto fail;
+    }
+    glp_set_obj_name(P, str);
+    free(str);
+    str = NULL;
+
+    if (m > 0) {
+        glp_add_rows(P, m);
+    }
+    if (n > 0) {
+        glp_add_cols(P, n);
+    }
+
+    for (i = 1; i <= m; i++) {
+        if ( rdInt(&rd, &type) || rdDbl(&rd, &lb) || rdDbl(&rd, &ub) ||
+             (type < GLP_FR) || (type > GLP_FX) || rdStr(&rd, &str) ) {
+            goto fail;
+        }
+        glp_set_row_bnds(P, i, type, lb, ub);
+        if (str != NULL) {
+            glp_set_row_name(P, i, str);
+            free(str);
+            str = NULL;
+        }
+    }
+
+    ind  = malloc(((size_t) m + 1) * sizeof(int));
+    val  = malloc(((size_t) m + 1) * sizeof(double));
+    mark = calloc((size_t) m + 1, sizeof(int));
+    if ( (ind == NULL) || (val == NULL) || (mark == NULL) ) {
+        goto fail;
+    }
+
+    for (j = 1; j <= n; j++) {
+        if ( rdInt(&rd, &type) || rdInt(&rd, &kind) ||
+             rdDbl(&rd, &lb) || rdDbl(&rd, &ub) || rdDbl(&rd, &coef) ||
+             rdInt(&rd, &clen) ||
+             (type < GLP_FR) || (type > GLP_FX) ||
+             (kind < GLP_CV) || (kind > GLP_BV) ||
+             (clen < 0) || (clen > m) || (nz + clen > nnz) ) {
+            goto fail;
+        }
+        nz += clen;
+        /* GLPK stops on duplicate row indices */
+        for (k = 1; k <= clen; k++) {
+            if ( rdInt(&rd, &ind[k]) || rdDbl(&rd, &val[k]) ||
+                 (ind[k] < 1) || (ind[k] > m) || (mark[ind[k]] == j) ) {
+                goto fail;
+            }
+            mark[ind[k]] = j;
+        }
+        if (rdStr(&rd, &str)) {
+            goto fail;
+        }
+        /* binary columns are stored with their 0/1 bounds, integer kind is
+           sufficient to restore them */
+        glp_set_col_kind(P, j, (kind == GLP_CV) ? GLP_CV : GLP_IV);
+        glp_set_col_bnds(P, j, type, lb, ub);
+        glp_set_obj_coef(P, j, coef);
+        if (clen > 0) {
+            glp_set_mat_col(P, j, clen, ind, val);
+        }
+        if (str != NULL) {
+            glp_set_col_name(P, j, str);
+            free(str);
+            str = NULL;
+        }
+    }
+
+    free(ind);
+    free(val);
+    free(mark);
+
+    if (nz != nnz) {
+        glp_erase_prob(P);
+        return 1;
+    }
+
+    return 0;
+
+fail:
+    free(str);
+    free(ind);
+    free(val);
+    free(mark);
+    glp_erase_prob(P);
+
+    return 1;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* files                                                                      */
+/* -------------------------------------------------------------------------- */
+
+int glpkSnapSave(const glpkBuf *buf, const char *fname) {
+
+    FILE *fh;
+    int err = 0;
+
+    fh = fopen(fname, "wb");
+    if (fh == NULL) {
+        return 1;
+    }
+    if (fwrite(buf->data, 1, buf->len, fh) != buf->len) {
+        err = 1;
+    }
+    if (fclose(fh) != 0) {
+        err = 1;
+    }
+
+    return err;
+}
+
+
+int glpkSnapLoad(glpkBuf *buf, const char *fname) {
+
+    FILE *fh;
+    unsigned char chunk[65536];
+    size_t nr;
+    int err = 0;
+
+    buf->len = 0;
+
+    fh = fopen(fname, "rb");
+    if (fh == NULL) {
+        return 1;
+    }
+    while ( (nr = fread(chunk, 1, sizeof(chunk), fh)) > 0 ) {
+        if (glpkBufPut(buf, chunk, nr)) {
+            err = 1;
+            break;
+        }
+    }
+    if (ferror(fh)) {
+        err = 1;
+    }
+    fclose(fh);
+
+    return err;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* streamed files                                                             */
+/* -------------------------------------------------------------------------- */
+
+static void fileInt(glpkSnapFile *sf, int val) {
+    if (fwrite(&val, sizeof(int), 1, sf->fh) != 1) {
+        sf->err = 1;
+    }
+}
+
+static void fileDbl(glpkSnapFile *sf, double val) {
+    if (fwrite(&val, sizeof(double), 1, sf->fh) != 1) {
+        sf->err = 1;
+    }
+}
+
+int glpkSnapFileOpen(glpkSnapFile *sf, const char *fname, int m, int n,
+                     int dir) {
+
+    int bom = SNAP_BOM;
+
+    sf->nnz = 0;
+    sf->err = 0;
+
+    sf->fh = fopen(fname, "wb");
+    if (sf->fh == NULL) {
+        return 1;
+    }
+
+    if (fwrite(snapMagic, sizeof(snapMagic), 1, sf->fh) != 1) {
+        sf->err = 1;
+    }
+    fileInt(sf, bom);
+    fileInt(sf, GLPK_SNAP_VERSION);
+    fileInt(sf, m);
+    fileInt(sf, n);
+    sf->nnzpos = ftell(sf->fh);
+    fileInt(sf, 0);
+    fileInt(sf, dir);
+    fileDbl(sf, 0.0);
+    /* no problem and objective name */
+    fileInt(sf, -1);
+    fileInt(sf, -1);
+
+    return sf->err;
+}
+
+void glpkSnapFileRow(glpkSnapFile *sf, int type, double lb, double ub) {
+    fileInt(sf, type);
+    fileDbl(sf, lb);
+    fileDbl(sf, ub);
+    fileInt(sf, -1);
+}
+
+void glpkSnapFileCol(glpkSnapFile *sf, int type, int kind, double lb,
+                     double ub, double coef, int len, const int *ind,
+                     const double *val) {
+
+    int k;
+
+    fileInt(sf, type);
+    fileInt(sf, kind);
+    fileDbl(sf, lb);
+    fileDbl(sf, ub);
+    fileDbl(sf, coef);
+    fileInt(sf, len);
+    for (k = 1; k <= len; k++) {
+        fileInt(sf, ind[k]);
+        fileDbl(sf, val[k]);
+    }
+    fileInt(sf, -1);
+
+    sf->nnz += len;
+}
+
+int glpkSnapFileClose(glpkSnapFile *sf) {
+
+    if ( (sf->nnzpos < 0) || (fseek(sf->fh, sf->nnzpos, SEEK_SET) != 0) ) {
+        sf->err = 1;
+    }
+    else {
+        fileInt(sf, sf->nnz);
+    }
+    if (fclose(sf->fh) != 0) {
+        sf->err = 1;
+    }
+    sf->fh = NULL;
+
+    return sf->err;
+}
@@ -0,0 +1,87 @@
+/* glpkSnapshot.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <glpk.h>
+
+
+/* -------------------------------------------------------------------------- */
+/* binary problem snapshots                                                   */
+/* -------------------------------------------------------------------------- */
+
+/* A snapshot is a compact binary image of a glp_prob (bounds, kinds,
+   objective, names and the constraint matrix in column major form). The
+   routines below use plain malloc/free and never call into R, so they may be
+   used from worker threads or forked processes. */
+
+/* version of the snapshot format */
+#define GLPK_SNAP_VERSION 1
+
+/* growable memory buffer */
+typedef struct {
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+} glpkBuf;
+
+/* append n bytes to a buffer, returns zero on success */
+int glpkBufPut(glpkBuf *buf, const void *src, size_t n);
+
+/* release the memory held by a buffer */
+void glpkBufFree(glpkBuf *buf);
+
+/* write problem object into buffer, returns zero on success */
+int glpkSnapWrite(glp_prob *P, glpkBuf *buf);
+
+/* rebuild problem object from a snapshot, returns zero on success */
+int glpkSnapRead(glp_prob *P, const unsigned char *data, size_t len);
+
+/* write buffer to file, returns zero on success */
+int glpkSnapSave(const glpkBuf *buf, const char *fname);
+
+/* read file into buffer, returns zero on success */
+int glpkSnapLoad(glpkBuf *buf, const char *fname);
+
+/* snapshot file written row by row and column by column, without a problem
+   object (rows first, then columns; names are not written) */
+typedef struct {
+    FILE *fh;
+    long nnzpos;    /* file position of the number of nonzeros */
+    int nnz;
+    int err;
+} glpkSnapFile;
+
+/* write the header, returns zero on success */
+int glpkSnapFileOpen(glpkSnapFile *sf, const char *fname, int m, int n,
+                     int dir);
+
+/* append one row or one column (ind and val are 1-based as in GLPK) */
+void glpkSnapFileRow(glpkSnapFile *sf, int type, double lb, double ub);
+void glpkSnapFileCol(glpkSnapFile *sf, int type, int kind, double lb,
+                     double ub, double coef, int len, const int *ind,
+                     const double *val);
+
+/* complete the header and close the file, returns zero on success */
+int glpkSnapFileClose(glpkSnapFile *sf);
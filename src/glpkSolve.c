@@ -0,0 +1,660 @@
+/* glpkSolve.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glpkR.h"
+#include "glpkProf.h"
+#include "glpkMem.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+
+
+static glpkStat solveStat[GLPK_SOLVER_NUM];
+
+
+/* -------------------------------------------------------------------------- */
+/* histogram                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/* bin 0 holds values below lo, bin b > 0 holds [lo * 10^((b-1)/d), lo *
+   10^(b/d)), the last bin everything above */
+static void histAdd(glpkHist *h, double lo, double x) {
+
+    int b;
+
+    if (h->n == 0) {
+        h->min = x;
+        h->max = x;
+    }
+    else {
+        if (x < h->min) {
+            h->min = x;
+        }
+        if (x > h->max) {
+            h->max = x;
+        }
+    }
+    h->n++;
+    h->sum += x;
+
+    if (x < lo) {
+        b = 0;
+    }
+    else {
+        b = 1 + (int) floor(GLPK_HIST_DEC * log10(x / lo));
+        if (b >= GLPK_HIST_BINS) {
+            b = GLPK_HIST_BINS - 1;
+        }
+    }
+    h->bin[b]++;
+}
+
+void glpkHistMerge(glpkHist *dest, const glpkHist *src) {
+
+    int b;
+
+    if (src->n == 0) {
+        return;
+    }
+    if ( (dest->n == 0) || (src->min < dest->min) ) {
+        dest->min = src->min;
+    }
+    if ( (dest->n == 0) || (src->max > dest->max) ) {
+        dest->max = src->max;
+    }
+    dest->n   += src->n;
+    dest->sum += src->sum;
+    for (b = 0; b < GLPK_HIST_BINS; b++) {
+        dest->bin[b] += src->bin[b];
+    }
+}
+
+/* the geometric center of the bin, limited to the observed range; the
+   relative error is below 10^(1/(2 * GLPK_HIST_DEC)) - 1, about 15% */
+double glpkHistQuantile(const glpkHist *h, double lo, double q) {
+
+    double rank, cum = 0, val;
+    int b;
+
+    if (h->n == 0) {
+        return R_NaN;
+    }
+
+    rank = q * h->n;
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    for (b = 0; b < GLPK_HIST_BINS - 1; b++) {
+        cum += h->bin[b];
+        if (cum >= rank) {
+            break;
+        }
+    }
+
+    if (b == 0) {
+        return h->min;
+    }
+
+    val = lo * pow(10.0, (b - 0.5) / GLPK_HIST_DEC);
+    if (val < h->min) {
+        val = h->min;
+    }
+    if (val > h->max) {
+        val = h->max;
+    }
+
+    return val;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* statistics                                                                 */
+/* -------------------------------------------------------------------------- */
+
+void glpkStatRecord(int solver, double secs, double iter, int ret) {
+
+    glpkStat *st = &solveStat[solver];
+
+    histAdd(&st->time, GLPK_HIST_TIME_LO, secs);
+    if (iter >= 0) {
+        histAdd(&st->iter, GLPK_HIST_ITER_LO, iter);
+    }
+    if ( (ret < 0) || (ret >= GLPK_STAT_NRET) ) {
+        ret = GLPK_STAT_NRET - 1;
+    }
+    st->ret[ret]++;
+}
+
+const glpkStat *glpkStatGet(int solver) {
+    return &solveStat[solver];
+}
+
+void glpkStatReset(void) {
+    memset(solveStat, 0, sizeof(solveStat));
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* solver calls                                                               */
+/* -------------------------------------------------------------------------- */
+
+int glpkItCnt(glp_prob *P) {
+#ifdef HAVE_GLP_GET_IT_CNT
+    return glp_get_it_cnt(P);
+#else
+    return -1;
+#endif
+}
+
+/* interrupt polling */
+int glpkSolveInterrupt = 1;
+
+
+/* -------------------------------------------------------------------------- */
+/* time budget                                                                */
+/* -------------------------------------------------------------------------- */
+
+static struct {
+    int on;
+    double deadline;   /* glpkProfTime() at the end of the budget */
+    double left;       /* solves still expected, 0 if unknown */
+    double skipped;    /* solves not started */
+    double stopped;    /* solves stopped by their share */
+} budget;
+
+void glpkBudgetSet(double secs, double nsolves) {
+
+    memset(&budget, 0, sizeof(budget));
+
+    if (ISNAN(secs)) {
+        return;
+    }
+
+    budget.on       = 1;
+    budget.deadline = glpkProfTime() + secs;
+    budget.left     = ( (ISNAN(nsolves)) || (nsolves < 1) ) ? 0 : nsolves;
+}
+
+int glpkBudgetGet(double *remaining, double *left, double *skipped,
+                  double *stopped) {
+
+    *remaining = budget.deadline - glpkProfTime();
+    *left      = budget.left;
+    *skipped   = budget.skipped;
+    *stopped   = budget.stopped;
+
+    return budget.on;
+}
+
+void glpkBudgetCount(double nsolves, double nstopped, double nskipped) {
+
+    double k;
+
+    if (!budget.on) {
+        return;
+    }
+
+    for (k = 0; (k < nsolves) && (budget.left > 1); k++) {
+        budget.left--;
+    }
+    budget.stopped += nstopped;
+    budget.skipped += nskipped;
+}
+
+/* Returns nonzero if the budget is exhausted and the solve must not start.
+   Otherwise, the time limit in milliseconds (tm_lim may be NULL if the
+   solver has none) is lowered to the share of the remaining time of this
+   solve, and *limited tells whether the share is below the limit of the
+   user. */
+static int budgetTake(int *tm_lim, int *limited) {
+
+    double rem, share;
+
+    *limited = 0;
+
+    if (!budget.on) {
+        return 0;
+    }
+
+    rem = budget.deadline - glpkProfTime();
+    if (rem <= 0) {
+        budget.skipped++;
+        return 1;
+    }
+
+    share = (budget.left > 1) ? rem / budget.left : rem;
+    if (budget.left > 1) {
+        budget.left--;
+    }
+
+    share = ceil(share * 1000.0);
+    if ( (tm_lim != NULL) && (share < (double) *tm_lim) ) {
+        *tm_lim  = (share < 1) ? 1 : (int) share;
+        *limited = 1;
+    }
+
+    return 0;
+}
+
+typedef struct {
+    double t0;
+    int it0;
+    int tout;
+    int hook;          /* terminal hook installed */
+    int silent;        /* output requested only for polling, swallow it */
+    int poll;          /* poll for user interrupts */
+    int budget;        /* time limit lowered by the time budget */
+    int intr;          /* user interrupt seen */
+    double tpoll;      /* time of the last poll */
+    double mem0;       /* bytes in use at start */
+    double tpeak0;     /* peak bytes of the session at start */
+    double mpeak;      /* largest sample of the bytes in use */
+    glpkProbInfo *info;
+    glpkLog *log;
+    glp_smcp *smcp;    /* working copy of the simplex parameters */
+    void (*cb_func)(glp_tree *T, void *info);
+    void *cb_info;     /* callback of the user (MIP) */
+} solveCtx;
+
+static void checkInterrupt(void *dummy) {
+    R_CheckUserInterrupt();
+}
+
+/* R_CheckUserInterrupt() does not return if an interrupt is pending; run it
+   in a top level context, so that GLPK is not left with a longjmp */
+static void pollInterrupt(solveCtx *ctx) {
+
+    double now;
+
+    if ( (!ctx->poll) || (ctx->intr) ) {
+        return;
+    }
+
+    now = glpkProfTime();
+    if (now - ctx->tpoll < GLPK_POLL_INTERVAL) {
+        return;
+    }
+    ctx->tpoll = now;
+
+    if (R_ToplevelExec(checkInterrupt, NULL) == FALSE) {
+        ctx->intr = 1;
+        /* the simplex solvers check the limits in every iteration */
+        if (ctx->smcp != NULL) {
+            ctx->smcp->it_lim = 0;
+            ctx->smcp->tm_lim = 0;
+        }
+    }
+}
+
+static void memSample(solveCtx *ctx) {
+
+    double total = glpkMemTotal();
+
+    if (total > ctx->mpeak) {
+        ctx->mpeak = total;
+    }
+}
+
+static int solveHook(void *info, const char *s) {
+
+    solveCtx *ctx = info;
+    int ret;
+
+    if (ctx->log != NULL) {
+        ret = glpkLogHook(ctx->log, s);
+    }
+    else {
+        ret = ( (ctx->silent) || (ctx->tout == GLP_OFF) ) ? 1 : 0;
+    }
+
+    memSample(ctx);
+    pollInterrupt(ctx);
+
+    return ret;
+}
+
+static void solveCallback(glp_tree *T, void *info) {
+
+    solveCtx *ctx = info;
+
+    if (ctx->cb_func != NULL) {
+        ctx->cb_func(T, ctx->cb_info);
+    }
+
+    memSample(ctx);
+    pollInterrupt(ctx);
+    if (ctx->intr) {
+        glp_ios_terminate(T);
+    }
+}
+
+/* msg_lev and out_frq are those of the working copy of the solver
+   parameters, or NULL if the solver can not be interrupted */
+static void solveBegin(solveCtx *ctx, glp_prob *P, glpkProbInfo *info,
+                       int iter, int *msg_lev, int *out_frq) {
+
+    double count, cpeak;
+
+    ctx->info    = info;
+    ctx->log     = ( (info != NULL) ? info->log : NULL );
+    ctx->poll    = ( (glpkSolveInterrupt) && (msg_lev != NULL) );
+    ctx->silent  = 0;
+    ctx->intr    = 0;
+    ctx->smcp    = NULL;
+    ctx->cb_func = NULL;
+    ctx->cb_info = NULL;
+    ctx->hook    = ( (ctx->log != NULL) || (ctx->poll) );
+
+    if ( (ctx->poll) && (*msg_lev < GLP_MSG_ON) ) {
+        /* GLPK calls the terminal hook only while it prints progress */
+        *msg_lev = GLP_MSG_ON;
+        if (out_frq != NULL) {
+            *out_frq = GLPK_POLL_OUT_FRQ;
+        }
+        ctx->silent = 1;
+    }
+
+    if (ctx->log != NULL) {
+        glpkLogBegin(ctx->log);
+    }
+
+    if (ctx->hook) {
+        /* the log is captured even if terminal output is switched off */
+        ctx->tout = glp_term_out(GLP_ON);
+        glp_term_hook(solveHook, ctx);
+    }
+
+    glpkMemUsage(&count, &cpeak, &ctx->mem0, &ctx->tpeak0);
+    ctx->mpeak = ctx->mem0;
+
+    ctx->it0   = (iter) ? glpkItCnt(P) : -1;
+    ctx->t0    = glpkProfTime();
+    ctx->tpoll = ctx->t0;
+}
+
+static int solveEnd(solveCtx *ctx, int solver, glp_prob *P, int ret) {
+
+    double secs = glpkProfTime() - ctx->t0;
+    double iter = (ctx->it0 < 0) ? -1.0 : (double) (glpkItCnt(P) - ctx->it0);
+    double count, cpeak, total, tpeak;
+
+    /* if the peak of the session grew, it was reached during this solve;
+       otherwise the largest sample is a lower bound of the peak */
+    glpkMemUsage(&count, &cpeak, &total, &tpeak);
+    if (ctx->info != NULL) {
+        ctx->info->mem.before = ctx->mem0;
+        ctx->info->mem.after  = total;
+        if (tpeak > ctx->tpeak0) {
+            ctx->info->mem.peak  = tpeak;
+            ctx->info->mem.exact = 1;
+        }
+        else {
+            ctx->info->mem.peak  = (total > ctx->mpeak) ? total : ctx->mpeak;
+            ctx->info->mem.exact = 0;
+        }
+        ctx->info->mem.solver = solver;
+    }
+
+    if (ctx->hook) {
+        glp_term_hook(NULL, NULL);
+        glp_term_out(ctx->tout);
+    }
+    if (ctx->log != NULL) {
+        glpkLogEnd(ctx->log);
+    }
+
+    /* a solve stopped by the user; if it finished anyway, keep the result */
+    if ( (ctx->intr) &&
+         ( (ret == GLP_EITLIM) || (ret == GLP_ETMLIM) || (ret == GLP_ESTOP) ) ) {
+        ret = GLPK_EINTR;
+    }
+    else if ( (ctx->budget) && (ret == GLP_ETMLIM) ) {
+        budget.stopped++;
+        ret = GLPK_EBUDGET;
+    }
+
+    glpkStatRecord(solver, secs, iter, ret);
+
+    return ret;
+}
+
+int glpkSolveSimplex(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info) {
+
+    solveCtx ctx;
+    glp_smcp lparm = *parm;
+    int ret;
+
+    if (budgetTake(&lparm.tm_lim, &ctx.budget) != 0) {
+        return GLPK_EBUDGET;
+    }
+
+    solveBegin(&ctx, P, info, 1, &lparm.msg_lev, &lparm.out_frq);
+    ctx.smcp = &lparm;
+    ret = glp_simplex(P, &lparm);
+
+    return solveEnd(&ctx, GLPK_SOLVER_SIMPLEX, P, ret);
+}
+
+/* glp_exact and glp_interior do not look at their parameters after the
+   start, they can not be interrupted */
+int glpkSolveExact(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info) {
+
+    solveCtx ctx;
+    glp_smcp lparm = *parm;
+    int ret;
+
+    if (budgetTake(&lparm.tm_lim, &ctx.budget) != 0) {
+        return GLPK_EBUDGET;
+    }
+
+    solveBegin(&ctx, P, info, 1, NULL, NULL);
+    ret = glp_exact(P, &lparm);
+
+    return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+}
+
+/* the share of the time budget is taken once for the whole hybrid solve,
+   every exact solve gets what is left of it */
+static void hybridLimit(solveCtx *ctx, glp_smcp *xparm, int tm_lim) {
+
+    double used;
+
+    if (ctx->budget) {
+        used = ceil((glpkProfTime() - ctx->t0) * 1000.0);
+        xparm->tm_lim = (used < (double) tm_lim - 1) ? tm_lim - (int) used
+                                                     : 1;
+    }
+}
+
+/* basis statuses of rows and columns, NULL if out of memory */
+static int *hybridBasis(glp_prob *P) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int *bs = malloc(((size_t) m + (size_t) n + 1) * sizeof(int));
+    int i, j;
+
+    if (bs != NULL) {
+        for (i = 1; i <= m; i++) {
+            bs[i] = glp_get_row_stat(P, i);
+        }
+        for (j = 1; j <= n; j++) {
+            bs[m+j] = glp_get_col_stat(P, j);
+        }
+    }
+
+    return bs;
+}
+
+static int hybridSameBasis(glp_prob *P, const int *bs) {
+
+    int m = glp_get_num_rows(P);
+    int n = glp_get_num_cols(P);
+    int i, j;
+
+    for (i = 1; i <= m; i++) {
+        if (glp_get_row_stat(P, i) != bs[i]) {
+            return 0;
+        }
+    }
+    for (j = 1; j <= n; j++) {
+        if (glp_get_col_stat(P, j) != bs[m+j]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* glp_exact starts from the basis in the problem object; after glp_simplex
+   this is usually optimal already and glp_exact only has to confirm it in
+   rational arithmetic. The hybrid solve takes one share of the time budget
+   and is recorded once, as exact solve. Whether glp_exact iterated is seen
+   from the basis, the iteration count is not available before GLPK 5.0. */
+int glpkSolveHybrid(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                    int *stage, int *xiter) {
+
+    solveCtx ctx;
+    glp_smcp lparm = *parm;
+    glp_smcp xparm;
+    int *bs;
+    int ret, it0, tm_lim;
+
+    *xiter = (glpkItCnt(P) < 0) ? -1 : 0;
+
+    if (budgetTake(&lparm.tm_lim, &ctx.budget) != 0) {
+        *stage = GLPK_HYBRID_STOPPED;
+        return GLPK_EBUDGET;
+    }
+    tm_lim = lparm.tm_lim;
+
+    solveBegin(&ctx, P, info, 1, &lparm.msg_lev, &lparm.out_frq);
+    ctx.smcp = &lparm;
+    ret = glp_simplex(P, &lparm);
+    /* glp_exact can not be interrupted */
+    ctx.smcp = NULL;
+
+    if ( (ctx.intr) || ( (ctx.budget) && (ret == GLP_ETMLIM) ) ) {
+        *stage = GLPK_HYBRID_STOPPED;
+        return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+    }
+    if (ret == GLP_EBOUND) {
+        /* glp_exact would fail the same way */
+        *stage = GLPK_HYBRID_FULL;
+        return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+    }
+
+    /* even if glp_simplex failed, its last basis may be valid */
+    xparm = lparm;
+    hybridLimit(&ctx, &xparm, tm_lim);
+    bs  = hybridBasis(P);
+    it0 = glpkItCnt(P);
+    ret = glp_exact(P, &xparm);
+    if (it0 >= 0) {
+        *xiter = glpkItCnt(P) - it0;
+    }
+
+    if (ret == 0) {
+        if (bs != NULL) {
+            *stage = (hybridSameBasis(P, bs)) ? GLPK_HYBRID_VERIFIED
+                                              : GLPK_HYBRID_REPAIRED;
+        }
+        else if (*xiter >= 0) {
+            *stage = (*xiter == 0) ? GLPK_HYBRID_VERIFIED
+                                   : GLPK_HYBRID_REPAIRED;
+        }
+        else {
+            *stage = GLPK_HYBRID_UNKNOWN;
+        }
+        free(bs);
+        return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+    }
+    free(bs);
+
+    if ( (ctx.budget) && (ret == GLP_ETMLIM) ) {
+        *stage = GLPK_HYBRID_STOPPED;
+        return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+    }
+
+    /* the basis is invalid or singular, or glp_exact did not finish from
+       it: full exact solve */
+    *stage = GLPK_HYBRID_FULL;
+    glp_std_basis(P);
+    hybridLimit(&ctx, &xparm, tm_lim);
+    it0 = glpkItCnt(P);
+    ret = glp_exact(P, &xparm);
+    if (it0 >= 0) {
+        *xiter += glpkItCnt(P) - it0;
+    }
+
+    if ( (ctx.budget) && (ret == GLP_ETMLIM) ) {
+        *stage = GLPK_HYBRID_STOPPED;
+    }
+
+    return solveEnd(&ctx, GLPK_SOLVER_EXACT, P, ret);
+}
+
+int glpkSolveInterior(glp_prob *P, const glp_iptcp *parm, glpkProbInfo *info) {
+
+    solveCtx ctx;
+    int ret;
+
+    /* glp_interior has no time limit, it only takes part in the budget */
+    if (budgetTake(NULL, &ctx.budget) != 0) {
+        return GLPK_EBUDGET;
+    }
+
+    /* the interior point solver does not count simplex iterations */
+    solveBegin(&ctx, P, info, 0, NULL, NULL);
+    ret = glp_interior(P, parm);
+
+    return solveEnd(&ctx, GLPK_SOLVER_INTERIOR, P, ret);
+}
+
+/* the callback stops the branch and bound search, the best integer feasible
+   solution found so far is kept */
+int glpkSolveMIP(glp_prob *P, const glp_iocp *parm, glpkProbInfo *info) {
+
+    solveCtx ctx;
+    glp_iocp lparm = *parm;
+    int ret;
+
+    if (budgetTake(&lparm.tm_lim, &ctx.budget) != 0) {
+        return GLPK_EBUDGET;
+    }
+
+    solveBegin(&ctx, P, info, 1, &lparm.msg_lev, NULL);
+    if (ctx.poll) {
+        ctx.cb_func   = lparm.cb_func;
+        ctx.cb_info   = lparm.cb_info;
+        lparm.cb_func = solveCallback;
+        lparm.cb_info = &ctx;
+    }
+    ret = glp_intopt(P, &lparm);
+
+    return solveEnd(&ctx, GLPK_SOLVER_MIP, P, ret);
+}
@@ -0,0 +1,159 @@
+/* glpkSolve.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* solver calls and solve statistics                                          */
+/* -------------------------------------------------------------------------- */
+
+/* All solver entry points call GLPK through the functions below, which
+   record wall clock time, simplex iterations and return code of each solve
+   in the session statistics and capture the solver log of the problem (see
+   glpkLog.h). Simplex and branch and bound poll for user interrupts from the
+   terminal hook and the MIP callback. */
+
+/* solvers */
+#define GLPK_SOLVER_SIMPLEX  0
+#define GLPK_SOLVER_EXACT    1
+#define GLPK_SOLVER_INTERIOR 2
+#define GLPK_SOLVER_MIP      3
+#define GLPK_SOLVER_NUM      4
+
+/* return code of a solve stopped by a user interrupt (not used by GLPK) */
+#define GLPK_EINTR 0x20
+
+/* interrupts are polled at most every GLPK_POLL_INTERVAL seconds; if the
+   user switched progress messages off, they are generated every
+   GLPK_POLL_OUT_FRQ iterations and dropped */
+#define GLPK_POLL_INTERVAL 0.1
+#define GLPK_POLL_OUT_FRQ  100
+
+/* nonzero if solves can be interrupted */
+extern int glpkSolveInterrupt;
+
+/* return code of a solve not started or stopped because the time budget is
+   exhausted (not used by GLPK) */
+#define GLPK_EBUDGET 0x21
+
+/* Time budget of the session: every solve gets an equal share of the
+   remaining time as time limit (if the share is lower than the limit given
+   by the user), solves after the deadline are not started. */
+
+/* set a budget of secs seconds for nsolves solves (nsolves < 1 or NaN if
+   unknown, then each solve may use all the remaining time), secs = NaN
+   removes the budget */
+void glpkBudgetSet(double secs, double nsolves);
+
+/* remaining time, expected solves, solves skipped and stopped; returns
+   nonzero if a budget is set */
+int glpkBudgetGet(double *remaining, double *left, double *skipped,
+                  double *stopped);
+
+/* count nsolves solves done by worker threads without glpkSolve* (see
+   glpkBudgetGet for their share), nstopped of them stopped by their share,
+   and nskipped solves not started after the deadline */
+void glpkBudgetCount(double nsolves, double nstopped, double nskipped);
+
+/* return codes 0 .. GLPK_STAT_NRET - 2 are counted separately, larger
+   ones in the last slot */
+#define GLPK_STAT_NRET 48
+
+/* fixed size histogram with GLPK_HIST_DEC bins per decade above lo */
+#define GLPK_HIST_DEC  8
+#define GLPK_HIST_BINS 96
+
+typedef struct {
+    double n;
+    double sum;
+    double min;
+    double max;
+    double bin[GLPK_HIST_BINS];
+} glpkHist;
+
+typedef struct {
+    glpkHist time;               /* seconds */
+    glpkHist iter;               /* simplex iterations */
+    double ret[GLPK_STAT_NRET];  /* counts per return code */
+} glpkStat;
+
+/* memory used by GLPK during the last solve of a problem (bytes, all
+   objects of the session) */
+typedef struct {
+    int solver;        /* -1 if not solved yet */
+    int exact;         /* peak is exact, otherwise a lower bound */
+    double before;
+    double peak;
+    double after;
+} glpkSolveMem;
+
+/* per problem data, kept in the protected slot of the problem pointer */
+typedef struct {
+    glpkLog *log;      /* captured solver log, NULL if not captured */
+    glpkSolveMem mem;  /* memory used by the last solve */
+    double bytes;      /* GLPK memory held by the problem object (estimate) */
+} glpkProbInfo;
+
+/* call glp_simplex, glp_exact, glp_interior, glp_intopt and record; info
+   may be NULL */
+int glpkSolveSimplex(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info);
+int glpkSolveExact(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info);
+int glpkSolveInterior(glp_prob *P, const glp_iptcp *parm, glpkProbInfo *info);
+int glpkSolveMIP(glp_prob *P, const glp_iocp *parm, glpkProbInfo *info);
+
+/* how glpkSolveHybrid obtained its result */
+#define GLPK_HYBRID_VERIFIED 0  /* basis of glp_simplex confirmed by glp_exact */
+#define GLPK_HYBRID_REPAIRED 1  /* glp_exact iterated from that basis */
+#define GLPK_HYBRID_FULL     2  /* glp_exact from the standard basis */
+#define GLPK_HYBRID_STOPPED  3  /* interrupted or out of time budget */
+#define GLPK_HYBRID_UNKNOWN  4  /* glp_exact succeeded, not known how */
+
+/* glp_simplex, followed by glp_exact starting from the final basis; only if
+   glp_exact can not use that basis, it solves again from the standard
+   basis. stage receives GLPK_HYBRID_*, xiter the iterations of glp_exact
+   (-1 if GLPK does not count them).
+   Takes one share of the time budget and is recorded as one exact solve. */
+int glpkSolveHybrid(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                    int *stage, int *xiter);
+
+/* simplex iterations done on P so far, -1 if GLPK does not report them */
+int glpkItCnt(glp_prob *P);
+
+/* record one solve; iter < 0 if unknown */
+void glpkStatRecord(int solver, double secs, double iter, int ret);
+
+/* statistics of one solver */
+const glpkStat *glpkStatGet(int solver);
+
+/* clear all statistics */
+void glpkStatReset(void);
+
+/* add the counts of src to dest */
+void glpkHistMerge(glpkHist *dest, const glpkHist *src);
+
+/* approximate quantile (0 <= q <= 1), NaN if empty */
+double glpkHistQuantile(const glpkHist *h, double lo, double q);
+
+/* lower limits of the time and iteration histograms */
+#define GLPK_HIST_TIME_LO 1e-7
+#define GLPK_HIST_ITER_LO 1.0
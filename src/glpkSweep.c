@@ -0,0 +1,378 @@
+/* glpkSweep.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkProf.h"
+#include "glpkTeam.h"
+#include "glpkSweep.h"
+
+
+/* -------------------------------------------------------------------------- */
+/* objective sweep                                                            */
+/* -------------------------------------------------------------------------- */
+
+int glpkSweepObj(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                 int nobj, const int *p, const int *ind, const double *val,
+                 double *obj, int *stat, int *ret, double *prim) {
+
+    glp_smcp lparm = *parm;
+    double *c0;
+    int n = glp_get_num_cols(P);
+    size_t e, ne = (size_t) n * (size_t) nobj;
+    int j, k, t, nsolved = 0;
+
+    for (k = 0; k < nobj; k++) {
+        obj[k]  = R_NaN;
+        stat[k] = 0;
+        ret[k]  = NA_INTEGER;
+    }
+    if (prim != NULL) {
+        for (e = 0; e < ne; e++) {
+            prim[e] = R_NaN;
+        }
+    }
+
+    c0 = malloc(((size_t) n + 1) * sizeof(double));
+    if (c0 == NULL) {
+        return -1;
+    }
+    for (j = 1; j <= n; j++) {
+        c0[j] = glp_get_obj_coef(P, j);
+        glp_set_obj_coef(P, j, 0);
+    }
+
+    lparm.meth     = GLP_PRIMAL;
+    lparm.presolve = GLP_OFF;
+
+    for (k = 0; k < nobj; k++) {
+        /* only the nonzeros of two objectives are touched */
+        if (k > 0) {
+            for (t = p[k-1]; t < p[k]; t++) {
+                glp_set_obj_coef(P, ind[t], 0);
+            }
+        }
+        for (t = p[k]; t < p[k+1]; t++) {
+            glp_set_obj_coef(P, ind[t], val[t]);
+        }
+
+        ret[k] = glpkSolveSimplex(P, &lparm, info);
+        if ( (ret[k] == GLPK_EINTR) || (ret[k] == GLPK_EBUDGET) ) {
+            break;
+        }
+        nsolved++;
+
+        stat[k] = glp_get_status(P);
+        obj[k]  = glp_get_obj_val(P);
+        if (prim != NULL) {
+            for (j = 1; j <= n; j++) {
+                prim[(size_t) k * n + j - 1] = glp_get_col_prim(P, j);
+            }
+        }
+    }
+
+    for (j = 1; j <= n; j++) {
+        glp_set_obj_coef(P, j, c0[j]);
+    }
+    free(c0);
+
+    return nsolved;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* grid of fixed values                                                       */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    glp_prob *P;             /* problem of the caller, only read */
+    const glp_smcp *parm;
+    glpkGrid *gr;
+    int nb;                  /* number of bands */
+    int next;                /* next band to solve */
+    int nw;                  /* workers started */
+    int budget;              /* a time budget is set */
+    double deadline;         /* glpkProfTime() at its end */
+    double left;             /* solves expected at the start, 0 if unknown */
+    int taken;               /* points started */
+    int stop;                /* the budget stopped the grid */
+    int nskip;               /* points not started after the deadline */
+    double *secs;            /* per point: wall clock time, */
+    double *iter;            /* simplex iterations (-1 if unknown) */
+    int *ret;                /* and return code, -1 if not solved */
+} gridData;
+
+/* Lowers the time limit of a point solved by a worker to its share of the
+   time budget: the remaining time divided by the points still expected,
+   times the number of workers solving points at the same time. Returns
+   nonzero if the grid is to be stopped. */
+static int gridBudget(gridData *gd, glpkTeam *tm, int *tm_lim, int *limited) {
+
+    double rem, nleft, share;
+    int stop = 0;
+
+    *limited = 0;
+
+    glpkTeamLock(tm);
+    if (gd->stop) {
+        stop = 1;
+    }
+    else if (gd->budget) {
+        rem = gd->deadline - glpkProfTime();
+        if (rem <= 0) {
+            gd->stop = 1;
+            gd->nskip++;
+            stop = 1;
+        }
+        else {
+            nleft = gd->left - gd->taken;
+            share = (nleft > gd->nw) ? rem * gd->nw / nleft : rem;
+            share = ceil(share * 1000.0);
+            if (share < (double) *tm_lim) {
+                *tm_lim  = (share < 1) ? 1 : (int) share;
+                *limited = 1;
+            }
+        }
+    }
+    if (!stop) {
+        gd->taken++;
+    }
+    glpkTeamUnlock(tm);
+
+    return stop;
+}
+
+/* solve Q at one grid point; without a team, Q is the problem of the user
+   and solved through glpkSolveSimplex, otherwise time, iterations and
+   return code are kept in gd for the main thread */
+static int gridPoint(glp_prob *Q, const glp_smcp *parm, glpkProbInfo *info,
+                     gridData *gd, int a, int b, glpkTeam *tm) {
+
+    glpkGrid *gr = gd->gr;
+    glp_smcp lparm = *parm;
+    size_t e = (size_t) b * gr->n1 + a;
+    double t0 = 0;
+    int ret, k, it0 = -1, limited = 0;
+
+    if (tm != NULL) {
+        if (gridBudget(gd, tm, &lparm.tm_lim, &limited) != 0) {
+            return GLPK_EBUDGET;
+        }
+        t0  = glpkProfTime();
+        it0 = glpkItCnt(Q);
+    }
+
+    glp_set_col_bnds(Q, gr->j1, GLP_FX, gr->g1[a], gr->g1[a]);
+    glp_set_col_bnds(Q, gr->j2, GLP_FX, gr->g2[b], gr->g2[b]);
+
+    /* an invalid starting basis is replaced once by the standard basis */
+    for (k = 0; k < 2; k++) {
+        ret = (tm == NULL) ? glpkSolveSimplex(Q, &lparm, info)
+                           : glp_simplex(Q, &lparm);
+        if ( (ret != GLP_EBADB) && (ret != GLP_ESING) &&
+             (ret != GLP_ECOND) ) {
+            break;
+        }
+        glp_std_basis(Q);
+    }
+
+    if (tm != NULL) {
+        if ( (limited) && (ret == GLP_ETMLIM) ) {
+            ret = GLPK_EBUDGET;
+            glpkTeamLock(tm);
+            gd->stop = 1;
+            glpkTeamUnlock(tm);
+        }
+        gd->secs[e] = glpkProfTime() - t0;
+        gd->iter[e] = (it0 < 0) ? -1.0 : (double) (glpkItCnt(Q) - it0);
+        gd->ret[e]  = ret;
+    }
+
+    if ( (ret == GLPK_EINTR) || (ret == GLPK_EBUDGET) ) {
+        return ret;
+    }
+
+    gr->stat[e] = (ret == 0) ? glp_get_status(Q) : 0;
+    gr->obj[e]  = (gr->stat[e] == GLP_OPT) ? glp_get_obj_val(Q) : R_NaN;
+
+    return 0;
+}
+
+/* rows a0 .. a1 - 1 along a serpentine path */
+static int gridBand(glp_prob *Q, const glp_smcp *parm, glpkProbInfo *info,
+                    gridData *gd, int a0, int a1, glpkTeam *tm) {
+
+    int a, b, k, ret = 0;
+    int n2 = gd->gr->n2;
+
+    for (a = a0; (a < a1) && (ret == 0); a++) {
+        for (k = 0; (k < n2) && (ret == 0); k++) {
+            if ( (tm != NULL) && (glpkTeamCancelled(tm)) ) {
+                return GLPK_EINTR;
+            }
+            b = ( ((a - a0) % 2) == 0 ) ? k : n2 - 1 - k;
+            ret = gridPoint(Q, parm, info, gd, a, b, tm);
+        }
+    }
+
+    return ret;
+}
+
+/* the bands are handed out in turn, so the workers started cover all of
+   them */
+static void gridWorker(glpkTeam *tm, int w, void *data) {
+
+    gridData *gd = data;
+    glp_smcp lparm = *gd->parm;
+    glp_prob *Q;
+    int a0, a1, c;
+
+    /* the terminal hook is called only while progress is printed */
+    lparm.msg_lev = GLP_MSG_ON;
+    lparm.out_frq = GLPK_POLL_OUT_FRQ;
+
+    glpkTeamLock(tm);
+    gd->nw++;
+    glpkTeamUnlock(tm);
+
+    Q = glp_create_prob();
+    glp_copy_prob(Q, gd->P, GLP_OFF);
+
+    for (;;) {
+        glpkTeamLock(tm);
+        c = gd->next++;
+        glpkTeamUnlock(tm);
+        if (c >= gd->nb) {
+            break;
+        }
+        a0 = (int) ((long) c * gd->gr->n1 / gd->nb);
+        a1 = (int) ((long) (c + 1) * gd->gr->n1 / gd->nb);
+        if (gridBand(Q, &lparm, NULL, gd, a0, a1, tm) != 0) {
+            break;
+        }
+    }
+
+    glp_delete_prob(Q);
+}
+
+/* solves of the workers go into the statistics and the time budget */
+static void gridRecord(gridData *gd, size_t ne) {
+
+    double nsolved = 0, nstopped = 0;
+    size_t e;
+
+    for (e = 0; e < ne; e++) {
+        if (gd->ret[e] < 0) {
+            continue;
+        }
+        glpkStatRecord(GLPK_SOLVER_SIMPLEX, gd->secs[e], gd->iter[e],
+                       gd->ret[e]);
+        nsolved++;
+        if (gd->ret[e] == GLPK_EBUDGET) {
+            nstopped++;
+        }
+    }
+
+    glpkBudgetCount(nsolved, nstopped, gd->nskip);
+}
+
+int glpkSweepGrid(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                  glpkGrid *gr, int nthreads, int *nworkers) {
+
+    glp_smcp lparm = *parm;
+    gridData gd;
+    double lb1, ub1, lb2, ub2, skipped, stopped;
+    int type1, type2;
+    size_t e, ne = (size_t) gr->n1 * (size_t) gr->n2;
+    int ret = 0, intr = 0;
+
+    for (e = 0; e < ne; e++) {
+        gr->obj[e]  = R_NaN;
+        gr->stat[e] = 0;
+    }
+
+    lparm.meth     = GLP_DUALP;
+    lparm.presolve = GLP_OFF;
+
+    gd.P    = P;
+    gd.parm = &lparm;
+    gd.gr   = gr;
+    gd.secs = NULL;
+    gd.iter = NULL;
+    gd.ret  = NULL;
+
+    *nworkers = 0;
+
+    if ( (nthreads > 1) && (gr->n1 > 1) ) {
+        gd.nb     = (nthreads < gr->n1) ? nthreads : gr->n1;
+        gd.next   = 0;
+        gd.nw     = 0;
+        gd.taken  = 0;
+        gd.stop   = 0;
+        gd.nskip  = 0;
+        gd.budget = glpkBudgetGet(&gd.deadline, &gd.left, &skipped, &stopped);
+        gd.deadline += glpkProfTime();
+        gd.secs   = malloc(ne * sizeof(double));
+        gd.iter   = malloc(ne * sizeof(double));
+        gd.ret    = malloc(ne * sizeof(int));
+
+        if ( (gd.secs != NULL) && (gd.iter != NULL) && (gd.ret != NULL) ) {
+            for (e = 0; e < ne; e++) {
+                gd.ret[e] = -1;
+            }
+            *nworkers = glpkTeamRun(gd.nb, 1, gridWorker, &gd, &intr);
+            if (*nworkers > 0) {
+                gridRecord(&gd, ne);
+            }
+        }
+
+        free(gd.secs);
+        free(gd.iter);
+        free(gd.ret);
+
+        if (*nworkers > 0) {
+            if (intr) {
+                return GLPK_EINTR;
+            }
+            return (gd.stop) ? GLPK_EBUDGET : 0;
+        }
+    }
+
+    type1 = glp_get_col_type(P, gr->j1);
+    lb1   = glp_get_col_lb(P, gr->j1);
+    ub1   = glp_get_col_ub(P, gr->j1);
+    type2 = glp_get_col_type(P, gr->j2);
+    lb2   = glp_get_col_lb(P, gr->j2);
+    ub2   = glp_get_col_ub(P, gr->j2);
+
+    ret = gridBand(P, &lparm, info, &gd, 0, gr->n1, NULL);
+
+    glp_set_col_bnds(P, gr->j1, type1, lb1, ub1);
+    glp_set_col_bnds(P, gr->j2, type2, lb2, ub2);
+
+    return ret;
+}
@@ -0,0 +1,74 @@
+/* glpkSweep.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* series of solves on one polytope                                           */
+/* -------------------------------------------------------------------------- */
+
+/* Every solve of a series starts from the final basis of the previous one
+   (presolver off) and goes through glpkSolveSimplex, so statistics, log,
+   interrupts and time budget apply to each. A series stops early at a user
+   interrupt or when the time budget is exhausted. */
+
+/* Objective sweep: objective k has the nonzero coefficients val[p[k]] ..
+   val[p[k+1] - 1] for the columns ind[p[k]] .. ind[p[k+1] - 1] (1-based);
+   all other coefficients are zero. Only the objective changes, so the
+   previous optimal basis stays primal feasible and the primal simplex
+   method is used. obj and stat (nobj elements) receive objective value and
+   status (NaN and 0 if not solved), ret the return codes; prim (n x nobj,
+   column major) the column primal values, if not NULL. The objective of P
+   is restored. Returns the number of objectives solved. */
+int glpkSweepObj(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                 int nobj, const int *p, const int *ind, const double *val,
+                 double *obj, int *stat, int *ret, double *prim);
+
+/* Grid of fixed values (phenotype phase plane, production envelope): column
+   j1 is fixed at g1[a], column j2 at g2[b] and the objective is optimized
+   for every point (a, b). Changing bounds keeps the previous basis dual
+   feasible, so the dual simplex method is used; each row of the grid is
+   traversed in the opposite direction of the previous one, so consecutive
+   points are neighbours. obj and stat (n1 x n2, column major) receive the
+   objective value (NaN if not optimal) and the status (0 if not solved). */
+typedef struct {
+    int j1;                  /* columns, 1-based */
+    int j2;
+    int n1;                  /* grid sizes */
+    int n2;
+    const double *g1;        /* grid values */
+    const double *g2;
+    double *obj;
+    int *stat;
+} glpkGrid;
+
+/* Solve all points of the grid. With nthreads > 1 the rows of the grid are
+   split into bands solved by worker threads on copies of P (see
+   glpkTeam.h), *nworkers receives the number of threads (0 if P was
+   solved here in series). Points solved by workers get their share of the
+   time budget like glpkSolveSimplex and are recorded in the statistics
+   when all workers have finished. The bounds of j1 and j2 in P are
+   restored.
+   Returns 0, GLPK_EINTR or GLPK_EBUDGET. */
+int glpkSweepGrid(glp_prob *P, const glp_smcp *parm, glpkProbInfo *info,
+                  glpkGrid *gr, int nthreads, int *nworkers);
@@ -0,0 +1,270 @@
+/* glpkTeam.c
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include "glpkR.h"
+#include "glpkLog.h"
+#include "glpkSolve.h"
+#include "glpkSnapshot.h"
+#include "glpkBatch.h"
+#include "glpkTeam.h"
+
+#if defined(HAVE_PTHREAD) && !defined(_WIN32)
+#include <pthread.h>
+#include <time.h>
+#define TEAM_THREADS
+#endif
+
+
+#ifdef TEAM_THREADS
+
+struct glpkTeam {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int cancel;
+    int running;
+    int glpk;
+    glpkTeamFunc fn;
+    void *data;
+};
+
+typedef struct {
+    glpkTeam *tm;
+    int w;
+    int aborting;
+    jmp_buf env;
+} teamWorker;
+
+
+/* -------------------------------------------------------------------------- */
+/* workers                                                                    */
+/* -------------------------------------------------------------------------- */
+
+/* progress messages are dropped; in a cancelled team, a GLPK error leaves
+   the solver through the error hook */
+static int teamHook(void *info, const char *s) {
+
+    teamWorker *tw = info;
+
+    if ( (!tw->aborting) && (glpkTeamCancelled(tw->tm)) ) {
+        tw->aborting = 1;
+        glp_error("%s\n", "solve cancelled");
+    }
+
+    return 1;
+}
+
+static void teamErrorHook(void *info) {
+    longjmp(((teamWorker *) info)->env, 1);
+}
+
+static void teamFinish(glpkTeam *tm) {
+
+    pthread_mutex_lock(&tm->lock);
+    tm->running--;
+    pthread_cond_signal(&tm->cond);
+    pthread_mutex_unlock(&tm->lock);
+}
+
+static void *teamThread(void *arg) {
+
+    teamWorker *tw = arg;
+
+    if (!tw->tm->glpk) {
+        tw->tm->fn(tw->tm, tw->w, tw->tm->data);
+        teamFinish(tw->tm);
+        return NULL;
+    }
+
+    if (setjmp(tw->env)) {
+        /* releases all problem objects of the worker */
+        glp_free_env();
+        teamFinish(tw->tm);
+        return NULL;
+    }
+
+    glp_error_hook(teamErrorHook, tw);
+    glp_term_hook(teamHook, tw);
+
+    tw->tm->fn(tw->tm, tw->w, tw->tm->data);
+
+    glp_error_hook(NULL, NULL);
+    glp_term_hook(NULL, NULL);
+    glp_free_env();
+    teamFinish(tw->tm);
+
+    return NULL;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* main thread                                                                */
+/* -------------------------------------------------------------------------- */
+
+static void checkInterrupt(void *dummy) {
+    R_CheckUserInterrupt();
+}
+
+static void teamWait(glpkTeam *tm, int *intr) {
+
+    struct timespec ts;
+    int poll;
+
+    pthread_mutex_lock(&tm->lock);
+    while (tm->running > 0) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += (long) (GLPK_POLL_INTERVAL * 1e9);
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&tm->cond, &tm->lock, &ts);
+        poll = ( (tm->running > 0) && (!tm->cancel) && (glpkSolveInterrupt) );
+        pthread_mutex_unlock(&tm->lock);
+        if ( (poll) && (R_ToplevelExec(checkInterrupt, NULL) == FALSE) ) {
+            *intr = 1;
+            glpkTeamCancel(tm);
+        }
+        pthread_mutex_lock(&tm->lock);
+    }
+    pthread_mutex_unlock(&tm->lock);
+}
+
+int glpkTeamAvailable(int glpk) {
+    return (glpk) ? glpkBatchThreadSafe() : 1;
+}
+
+int glpkTeamRun(int nw, int glpk, glpkTeamFunc fn, void *data, int *intr) {
+
+    glpkTeam tm;
+    teamWorker *tw;
+    pthread_t *tid;
+    int w, nstarted = 0;
+
+    *intr = 0;
+
+    if ( (nw < 1) || (!glpkTeamAvailable(glpk)) ) {
+        return 0;
+    }
+
+    tw  = malloc((size_t) nw * sizeof(teamWorker));
+    tid = malloc((size_t) nw * sizeof(pthread_t));
+    if ( (tw == NULL) || (tid == NULL) ) {
+        free(tw);
+        free(tid);
+        return 0;
+    }
+
+    pthread_mutex_init(&tm.lock, NULL);
+    pthread_cond_init(&tm.cond, NULL);
+    tm.cancel  = 0;
+    tm.running = 0;
+    tm.glpk    = glpk;
+    tm.fn      = fn;
+    tm.data    = data;
+
+    for (w = 0; w < nw; w++) {
+        tw[nstarted].tm       = &tm;
+        tw[nstarted].w        = w;
+        tw[nstarted].aborting = 0;
+        pthread_mutex_lock(&tm.lock);
+        tm.running++;
+        pthread_mutex_unlock(&tm.lock);
+        if (pthread_create(&tid[nstarted], NULL, teamThread,
+                           &tw[nstarted]) == 0) {
+            nstarted++;
+        }
+        else {
+            pthread_mutex_lock(&tm.lock);
+            tm.running--;
+            pthread_mutex_unlock(&tm.lock);
+        }
+    }
+
+    teamWait(&tm, intr);
+
+    for (w = 0; w < nstarted; w++) {
+        pthread_join(tid[w], NULL);
+    }
+
+    pthread_cond_destroy(&tm.cond);
+    pthread_mutex_destroy(&tm.lock);
+    free(tw);
+    free(tid);
+
+    return nstarted;
+}
+
+void glpkTeamCancel(glpkTeam *tm) {
+
+    pthread_mutex_lock(&tm->lock);
+    tm->cancel = 1;
+    pthread_mutex_unlock(&tm->lock);
+}
+
+int glpkTeamCancelled(glpkTeam *tm) {
+
+    int c;
+
+    pthread_mutex_lock(&tm->lock);
+    c = tm->cancel;
+    pthread_mutex_unlock(&tm->lock);
+
+    return c;
+}
+
+void glpkTeamLock(glpkTeam *tm) {
+    pthread_mutex_lock(&tm->lock);
+}
+
+void glpkTeamUnlock(glpkTeam *tm) {
+    pthread_mutex_unlock(&tm->lock);
+}
+
+#else
+
+int glpkTeamAvailable(int glpk) {
+    return 0;
+}
+
+int glpkTeamRun(int nw, int glpk, glpkTeamFunc fn, void *data, int *intr) {
+    *intr = 0;
+    return 0;
+}
+
+void glpkTeamCancel(glpkTeam *tm) {
+}
+
+int glpkTeamCancelled(glpkTeam *tm) {
+    return 0;
+}
+
+void glpkTeamLock(glpkTeam *tm) {
+}
+
+void glpkTeamUnlock(glpkTeam *tm) {
+}
+
+#endif /* TEAM_THREADS */
@@ -0,0 +1,64 @@
+/* glpkTeam.h
+   R interface to GLPK.
+
+   Copyright (C) 2011-2014 Gabriel Gelius-Dietrich, Dpt. for Bioinformatics,
+   Institute for Informatics, Heinrich-Heine-University, Duesseldorf, Germany.
+   All right reserved.
+   Email: geliudie@uni-duesseldorf.de
+
+   This file is part of glpkAPI.
+
+   GlpkAPI is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   GlpkAPI is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with glpkAPI.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/* -------------------------------------------------------------------------- */
+/* teams of worker threads solving copies of a problem                        */
+/* -------------------------------------------------------------------------- */
+
+/* Every worker is a thread. Workers calling GLPK get their own GLPK
+   environment, released when the worker returns; problem objects of the main thread may be read (e.g. by
+   glp_copy_prob) but not changed by the workers, which never call into R.
+   The main thread waits for the workers and polls for user interrupts
+   meanwhile. A cancelled team stops its workers at the next output of the
+   solvers: the terminal hook raises a GLPK error and the worker leaves
+   through the error hook. So workers have to switch solver messages on
+   (msg_lev GLP_MSG_ON, out_frq GLPK_POLL_OUT_FRQ), the output is dropped.
+   Workers should check glpkTeamCancelled between solves. */
+
+typedef struct glpkTeam glpkTeam;
+
+/* body of worker w (0 <= w < nw) */
+typedef void (*glpkTeamFunc)(glpkTeam *tm, int w, void *data);
+
+/* nonzero if workers can be started: POSIX threads, and GLPK built with
+   thread local storage if glpk is nonzero */
+int glpkTeamAvailable(int glpk);
+
+/* run nw workers and wait for them; glpk is nonzero if the workers call
+   GLPK. *intr is set nonzero after a user interrupt. Returns the number of
+   workers started, zero if none (then the caller has to do the work
+   itself). */
+int glpkTeamRun(int nw, int glpk, glpkTeamFunc fn, void *data, int *intr);
+
+/* stop all workers of the team */
+void glpkTeamCancel(glpkTeam *tm);
+
+/* nonzero if the team was cancelled */
+int glpkTeamCancelled(glpkTeam *tm);
+
+/* serialize access of workers to shared data; no GLPK routine printing
+   output may be called while the lock is held */
+void glpkTeamLock(glpkTeam *tm);
+void glpkTeamUnlock(glpkTeam *tm);
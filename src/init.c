@@ -26,171 +26,294 @@
 #include <Rinternals.h>
 
 #include "glpkAPI.h"
+#include "glpkProf.h"
+#include "glpkMem.h"
 
 #include <R_ext/Rdynload.h>
 
+
+/* -------------------------------------------------------------------------- */
+/* registered routines: X(name, number of arguments)                          */
+/* -------------------------------------------------------------------------- */
+
+#define GLPK_CALL_METHODS(X) \
+    X(isGLPKptr,           1) \
+    X(isTRWKSptr,          1) \
+    X(isNULLptr,           1) \
+    X(initGLPK,            0) \
+    X(delProb,             1) \
+    X(eraseProb,           1) \
+    X(copyProb,            3) \
+    X(initProb,            1) \
+    X(setProbName,         2) \
+    X(getProbName,         1) \
+    X(setObjName,          2) \
+    X(getObjName,          1) \
+    X(createIndex,         1) \
+    X(deleteIndex,         1) \
+    X(setDefaultSmpParm,   0) \
+    X(setDefaultIptParm,   0) \
+    X(setDefaultMIPParm,   0) \
+    X(setSimplexParm,      6) \
+    X(setInteriorParm,     3) \
+    X(setMIPParm,          6) \
+    X(getSimplexParm,      0) \
+    X(getInteriorParm,     0) \
+    X(getMIPParm,          0) \
+    X(setObjDir,           2) \
+    X(getObjDir,           1) \
+    X(addRows,             2) \
+    X(setRowName,          3) \
+    X(setRowsNames,        3) \
+    X(getRowName,          2) \
+    X(findRow,             2) \
+    X(addCols,             2) \
+    X(setColName,          3) \
+    X(setColsNames,        3) \
+    X(getColName,          2) \
+    X(findCol,             2) \
+    X(getNumRows,          1) \
+    X(getNumCols,          1) \
+    X(setColsBnds,         5) \
+    X(setColsBndsObjCoefs, 6) \
+    X(setColBnd,           5) \
+    X(getColsLowBnds,      2) \
+    X(getColLowBnd,        2) \
+    X(getColsUppBnds,      2) \
+    X(getColUppBnd,        2) \
+    X(setColKind,          3) \
+    X(setColsKind,         3) \
+    X(getColKind,          2) \
+    X(getColsKind,         2) \
+    X(getNumInt,           1) \
+    X(getNumBin,           1) \
+    X(setRowsBnds,         5) \
+    X(setRhsZero,          1) \
+    X(setRowBnd,           5) \
+    X(getRowsLowBnds,      2) \
+    X(getRowLowBnd,        2) \
+    X(getRowsUppBnds,      2) \
+    X(getRowUppBnd,        2) \
+    X(getRowType,          2) \
+    X(getRowsTypes,        2) \
+    X(getColType,          2) \
+    X(setObjCoefs,         3) \
+    X(setObjCoef,          3) \
+    X(getObjCoefs,         2) \
+    X(getObjCoef,          2) \
+    X(loadMatrix,          5) \
+    X(checkDup,            5) \
+    X(sortMatrix,          1) \
+    X(delRows,             3) \
+    X(delCols,             3) \
+    X(setRii,              3) \
+    X(setSjj,              3) \
+    X(getRii,              2) \
+    X(getSjj,              2) \
+    X(scaleProb,           2) \
+    X(unscaleProb,         1) \
+    X(setRowStat,          3) \
+    X(setColStat,          3) \
+    X(stdBasis,            1) \
+    X(advBasis,            1) \
+    X(cpxBasis,            1) \
+    X(warmUp,              1) \
+    X(termOut,             1) \
+    X(solveSimplex,        1) \
+    X(solveSimplexExact,   1) \
+    X(solveSimplexHybrid,  1) \
+    X(getObjVal,           1) \
+    X(getSolStat,          1) \
+    X(getColsPrim,         1) \
+    X(getColPrim,          2) \
+    X(getPrimStat,         1) \
+    X(getDualStat,         1) \
+    X(getRowStat,          2) \
+    X(getRowsStat,         1) \
+    X(getRowPrim,          2) \
+    X(getRowsPrim,         1) \
+    X(getRowDual,          2) \
+    X(getRowsDual,         1) \
+    X(getColStat,          2) \
+    X(getColsStat,         1) \
+    X(getColDual,          2) \
+    X(getColsDual,         1) \
+    X(getUnbndRay,         1) \
+    X(solveInterior,       1) \
+    X(crossover,           2) \
+    X(solveConcurrent,     2) \
+    X(sweepObj,            5) \
+    X(sweepGrid,           6) \
+    X(solveNormL1,         5) \
+    X(addLoopless,         4) \
+    X(sampleACHR,          7) \
+    X(findBlocked,         5) \
+    X(reduceProb,          3) \
+    X(postsolve,           3) \
+    X(findDepRows,         3) \
+    X(getObjValIpt,        1) \
+    X(getSolStatIpt,       1) \
+    X(getColsPrimIpt,      1) \
+    X(getColPrimIpt,       2) \
+    X(getRowPrimIpt,       2) \
+    X(getRowsPrimIpt,      1) \
+    X(getRowDualIpt,       2) \
+    X(getRowsDualIpt,      1) \
+    X(getColDualIpt,       2) \
+    X(getColsDualIpt,      1) \
+    X(solveMIP,            1) \
+    X(mipStatus,           1) \
+    X(mipObjVal,           1) \
+    X(mipRowVal,           2) \
+    X(mipRowsVal,          1) \
+    X(mipColVal,           2) \
+    X(mipColsVal,          1) \
+    X(getNumNnz,           1) \
+    X(getMatRow,           2) \
+    X(setMatRow,           5) \
+    X(getMatCol,           2) \
+    X(setMatCol,           5) \
+    X(readMPS,             3) \
+    X(readLP,              2) \
+    X(readProb,            2) \
+    X(writeMPS,            3) \
+    X(writeLP,             2) \
+    X(writeProb,           2) \
+    X(printSol,            2) \
+    X(readSol,             2) \
+    X(writeSol,            2) \
+    X(printIpt,            2) \
+    X(readIpt,             2) \
+    X(writeIpt,            2) \
+    X(printMIP,            2) \
+    X(readMIP,             2) \
+    X(writeMIP,            2) \
+    X(version,             0) \
+    X(bfExists,            1) \
+    X(factorize,           1) \
+    X(bfUpdated,           1) \
+    X(setBfcp,             7) \
+    X(getBfcp,             1) \
+    X(getBhead,            2) \
+    X(getRbind,            2) \
+    X(getCbind,            2) \
+    X(printRanges,         4) \
+    X(mplAllocWksp,        1) \
+    X(mplFreeWksp,         1) \
+    X(mplReadModel,        3) \
+    X(mplReadData,         2) \
+    X(mplGenerate,         2) \
+    X(mplBuildProb,        2) \
+    X(mplPostsolve,        3) \
+    X(mplSetCache,         3) \
+    X(mplGetCache,         0) \
+    X(mplClearCache,       1) \
+    X(mplCachedProb,       5) \
+    X(mplBindData,         4) \
+    X(mplBuildBatch,       6) \
+    X(readSnap,            2) \
+    X(writeSnap,           2) \
+    X(genModel,            4) \
+    X(getCheckArgs,        0) \
+    X(setCheckArgs,        1) \
+    X(setProfiling,        1) \
+    X(getProfiling,        0) \
+    X(resetProfiling,      0) \
+    X(getSolveStats,       0) \
+    X(resetSolveStats,     0) \
+    X(setInterrupt,        1) \
+    X(getMemUsage,         0) \
+    X(setMemLimit,         1) \
+    X(getSolveMem,         1) \
+    X(setGcTrigger,        1) \
+    X(setTimeBudget,       2) \
+    X(getTimeBudget,       0) \
+    X(setLogCapture,       5) \
+    X(getLog,              1) \
+    X(clearLog,            1)
+
+
+/* -------------------------------------------------------------------------- */
+/* profiling wrappers                                                         */
+/* -------------------------------------------------------------------------- */
+
+/* every routine is registered through a wrapper prof_<name>; with profiling
+   switched off, the wrapper only tests glpkProfEnabled */
+
+#define PROF_ARGS0 void
+#define PROF_ARGS1 SEXP a1
+#define PROF_ARGS2 PROF_ARGS1, SEXP a2
+#define PROF_ARGS3 PROF_ARGS2, SEXP a3
+#define PROF_ARGS4 PROF_ARGS3, SEXP a4
+#define PROF_ARGS5 PROF_ARGS4, SEXP a5
+#define PROF_ARGS6 PROF_ARGS5, SEXP a6
+#define PROF_ARGS7 PROF_ARGS6, SEXP a7
+
+#define PROF_VALS0
+#define PROF_VALS1 a1
+#define PROF_VALS2 PROF_VALS1, a2
+#define PROF_VALS3 PROF_VALS2, a3
+#define PROF_VALS4 PROF_VALS3, a4
+#define PROF_VALS5 PROF_VALS4, a5
+#define PROF_VALS6 PROF_VALS5, a6
+#define PROF_VALS7 PROF_VALS6, a7
+
+#define PROF_NEXT0
+#define PROF_NEXT1 , PROF_VALS1
+#define PROF_NEXT2 , PROF_VALS2
+#define PROF_NEXT3 , PROF_VALS3
+#define PROF_NEXT4 , PROF_VALS4
+#define PROF_NEXT5 , PROF_VALS5
+#define PROF_NEXT6 , PROF_VALS6
+#define PROF_NEXT7 , PROF_VALS7
+
+#define PROF_ID(name, n) PROF_ID_##name,
+enum { GLPK_CALL_METHODS(PROF_ID) PROF_NUM };
+
+#define PROF_NAME(name, n) #name,
+static const char *profNames[] = { GLPK_CALL_METHODS(PROF_NAME) NULL };
+
+/* while a memory limit is set, the entry point is called under a guard
+   catching GLPK runtime errors (see glpkMem.h) */
+#define GUARD_WRAPPER(name, n) \
+static SEXP guard_##name(PROF_ARGS##n) { \
+    SEXP args[8] = { R_NilValue PROF_NEXT##n }; \
+    if (glpkMemLimit > 0) { \
+        return glpkGuardCall(#name, (DL_FUNC) &name, n, args + 1); \
+    } \
+    return name(PROF_VALS##n); \
+}
+GLPK_CALL_METHODS(GUARD_WRAPPER)
+
+#define PROF_WRAPPER(name, n) \
+static SEXP prof_##name(PROF_ARGS##n) { \
+    SEXP out; \
+    double t0; \
+    if (!glpkProfEnabled) { \
+        return guard_##name(PROF_VALS##n); \
+    } \
+    t0 = glpkProfStart(PROF_ID_##name); \
+    out = guard_##name(PROF_VALS##n); \
+    glpkProfStop(PROF_ID_##name, t0, \
+                 glpkProfElements(out, n PROF_NEXT##n)); \
+    return out; \
+}
+GLPK_CALL_METHODS(PROF_WRAPPER)
+
+
+/* -------------------------------------------------------------------------- */
+/* registration                                                               */
+/* -------------------------------------------------------------------------- */
+
+#define CALL_DEF(name, n) {#name, (DL_FUNC) &prof_##name, n},
 static const R_CallMethodDef callMethods[] = {
-    {"isGLPKptr",           (DL_FUNC) &isGLPKptr,           1},
-    {"isTRWKSptr",          (DL_FUNC) &isTRWKSptr,          1},
-    {"isNULLptr",           (DL_FUNC) &isNULLptr,           1},
-    {"initGLPK",            (DL_FUNC) &initGLPK,            0},
-    {"delProb",             (DL_FUNC) &delProb,             1},
-    {"eraseProb",           (DL_FUNC) &eraseProb,           1},
-    {"copyProb",            (DL_FUNC) &copyProb,            3},
-    {"initProb",            (DL_FUNC) &initProb,            1},
-    {"setProbName",         (DL_FUNC) &setProbName,         2},
-    {"getProbName",         (DL_FUNC) &getProbName,         1},
-    {"setObjName",          (DL_FUNC) &setObjName,          2},
-    {"getObjName",          (DL_FUNC) &getObjName,          1},
-    {"createIndex",         (DL_FUNC) &createIndex,         1},
-    {"deleteIndex",         (DL_FUNC) &deleteIndex,         1},
-    {"setDefaultSmpParm",   (DL_FUNC) &setDefaultSmpParm,   0},
-    {"setDefaultIptParm",   (DL_FUNC) &setDefaultIptParm,   0},
-    {"setDefaultMIPParm",   (DL_FUNC) &setDefaultMIPParm,   0},
-    {"setSimplexParm",      (DL_FUNC) &setSimplexParm,      6},
-    {"setInteriorParm",     (DL_FUNC) &setInteriorParm,     3},
-    {"setMIPParm",          (DL_FUNC) &setMIPParm,          6},
-    {"getSimplexParm",      (DL_FUNC) &getSimplexParm,      0},
-    {"getInteriorParm",     (DL_FUNC) &getInteriorParm,     0},
-    {"getMIPParm",          (DL_FUNC) &getMIPParm,          0},
-    {"setObjDir",           (DL_FUNC) &setObjDir,           2},
-    {"getObjDir",           (DL_FUNC) &getObjDir,           1},
-    {"addRows",             (DL_FUNC) &addRows,             2},
-    {"setRowName",          (DL_FUNC) &setRowName,          3},
-    {"setRowsNames",        (DL_FUNC) &setRowsNames,        3},
-    {"getRowName",          (DL_FUNC) &getRowName,          2},
-    {"findRow",             (DL_FUNC) &findRow,             2},
-    {"addCols",             (DL_FUNC) &addCols,             2},
-    {"setColName",          (DL_FUNC) &setColName,          3},
-    {"setColsNames",        (DL_FUNC) &setColsNames,        3},
-    {"getColName",          (DL_FUNC) &getColName,          2},
-    {"findCol",             (DL_FUNC) &findCol,             2},
-    {"getNumRows",          (DL_FUNC) &getNumRows,          1},
-    {"getNumCols",          (DL_FUNC) &getNumCols,          1},
-    {"setColsBnds",         (DL_FUNC) &setColsBnds,         5},
-    {"setColsBndsObjCoefs", (DL_FUNC) &setColsBndsObjCoefs, 6},
-    {"setColBnd",           (DL_FUNC) &setColBnd,           5},
-    {"getColsLowBnds",      (DL_FUNC) &getColsLowBnds,      2},
-    {"getColLowBnd",        (DL_FUNC) &getColLowBnd,        2},
-    {"getColsUppBnds",      (DL_FUNC) &getColsUppBnds,      2},
-    {"getColUppBnd",        (DL_FUNC) &getColUppBnd,        2},
-    {"setColKind",          (DL_FUNC) &setColKind,          3},
-    {"setColsKind",         (DL_FUNC) &setColsKind,         3},
-    {"getColKind",          (DL_FUNC) &getColKind,          2},
-    {"getColsKind",         (DL_FUNC) &getColsKind,         2},
-    {"getNumInt",           (DL_FUNC) &getNumInt,           1},
-    {"getNumBin",           (DL_FUNC) &getNumBin,           1},
-    {"setRowsBnds",         (DL_FUNC) &setRowsBnds,         5},
-    {"setRhsZero",          (DL_FUNC) &setRhsZero,          1},
-    {"setRowBnd",           (DL_FUNC) &setRowBnd,           5},
-    {"getRowsLowBnds",      (DL_FUNC) &getRowsLowBnds,      2},
-    {"getRowLowBnd",        (DL_FUNC) &getRowLowBnd,        2},
-    {"getRowsUppBnds",      (DL_FUNC) &getRowsUppBnds,      2},
-    {"getRowUppBnd",        (DL_FUNC) &getRowUppBnd,        2},
-    {"getRowType",          (DL_FUNC) &getRowType,          2},
-    {"getRowsTypes",        (DL_FUNC) &getRowsTypes,        2},
-    {"getColType",          (DL_FUNC) &getColType,          2},
-    {"setObjCoefs",         (DL_FUNC) &setObjCoefs,         3},
-    {"setObjCoef",          (DL_FUNC) &setObjCoef,          3},
-    {"getObjCoefs",         (DL_FUNC) &getObjCoefs,         2},
-    {"getObjCoef",          (DL_FUNC) &getObjCoef,          2},
-    {"loadMatrix",          (DL_FUNC) &loadMatrix,          5},
-    {"checkDup",            (DL_FUNC) &checkDup,            5},
-    {"sortMatrix",          (DL_FUNC) &sortMatrix,          1},
-    {"delRows",             (DL_FUNC) &delRows,             3},
-    {"delCols",             (DL_FUNC) &delCols,             3},
-    {"setRii",              (DL_FUNC) &setRii,              3},
-    {"setSjj",              (DL_FUNC) &setSjj,              3},
-    {"getRii",              (DL_FUNC) &getRii,              2},
-    {"getSjj",              (DL_FUNC) &getSjj,              2},
-    {"scaleProb",           (DL_FUNC) &scaleProb,           2},
-    {"unscaleProb",         (DL_FUNC) &unscaleProb,         1},
-    {"setRowStat",          (DL_FUNC) &setRowStat,          3},
-    {"setColStat",          (DL_FUNC) &setColStat,          3},
-    {"stdBasis",            (DL_FUNC) &stdBasis,            1},
-    {"advBasis",            (DL_FUNC) &advBasis,            1},
-    {"cpxBasis",            (DL_FUNC) &cpxBasis,            1},
-    {"warmUp",              (DL_FUNC) &warmUp,              1},
-    {"termOut",             (DL_FUNC) &termOut,             1},
-    {"solveSimplex",        (DL_FUNC) &solveSimplex,        1},
-    {"solveSimplexExact",   (DL_FUNC) &solveSimplexExact,   1},
-    {"getObjVal",           (DL_FUNC) &getObjVal,           1},
-    {"getSolStat",          (DL_FUNC) &getSolStat,          1},
-    {"getColsPrim",         (DL_FUNC) &getColsPrim,         1},
-    {"getColPrim",          (DL_FUNC) &getColPrim,          2},
-    {"getPrimStat",         (DL_FUNC) &getPrimStat,         1},
-    {"getDualStat",         (DL_FUNC) &getDualStat,         1},
-    {"getRowStat",          (DL_FUNC) &getRowStat,          2},
-    {"getRowsStat",         (DL_FUNC) &getRowsStat,         1},
-    {"getRowPrim",          (DL_FUNC) &getRowPrim,          2},
-    {"getRowsPrim",         (DL_FUNC) &getRowsPrim,         1},
-    {"getRowDual",          (DL_FUNC) &getRowDual,          2},
-    {"getRowsDual",         (DL_FUNC) &getRowsDual,         1},
-    {"getColStat",          (DL_FUNC) &getColStat,          2},
-    {"getColsStat",         (DL_FUNC) &getColsStat,         1},
-    {"getColDual",          (DL_FUNC) &getColDual,          2},
-    {"getColsDual",         (DL_FUNC) &getColsDual,         1},
-    {"getUnbndRay",         (DL_FUNC) &getUnbndRay,         1},
-    {"solveInterior",       (DL_FUNC) &solveInterior,       1},
-    {"getObjValIpt",        (DL_FUNC) &getObjValIpt,        1},
-    {"getSolStatIpt",       (DL_FUNC) &getSolStatIpt,       1},
-    {"getColsPrimIpt",      (DL_FUNC) &getColsPrimIpt,      1},
-    {"getColPrimIpt",       (DL_FUNC) &getColPrimIpt,       2},
-    {"getRowPrimIpt",       (DL_FUNC) &getRowPrimIpt,       2},
-    {"getRowsPrimIpt",      (DL_FUNC) &getRowsPrimIpt,      1},
-    {"getRowDualIpt",       (DL_FUNC) &getRowDualIpt,       2},
-    {"getRowsDualIpt",      (DL_FUNC) &getRowsDualIpt,      1},
-    {"getColDualIpt",       (DL_FUNC) &getColDualIpt,       2},
-    {"getColsDualIpt",      (DL_FUNC) &getColsDualIpt,      1},
-    {"solveMIP",            (DL_FUNC) &solveMIP,            1},
-    {"mipStatus",           (DL_FUNC) &mipStatus,           1},
-    {"mipObjVal",           (DL_FUNC) &mipObjVal,           1},
-    {"mipRowVal",           (DL_FUNC) &mipRowVal,           2},
-    {"mipRowsVal",          (DL_FUNC) &mipRowsVal,          1},
-    {"mipColVal",           (DL_FUNC) &mipColVal,           2},
-    {"mipColsVal",          (DL_FUNC) &mipColsVal,          1},
-    {"getNumNnz",           (DL_FUNC) &getNumNnz,           1},
-    {"getMatRow",           (DL_FUNC) &getMatRow,           2},
-    {"setMatRow",           (DL_FUNC) &setMatRow,           5},
-    {"getMatCol",           (DL_FUNC) &getMatCol,           2},
-    {"setMatCol",           (DL_FUNC) &setMatCol,           5},
-    {"readMPS",             (DL_FUNC) &readMPS,             3},
-    {"readLP",              (DL_FUNC) &readLP,              2},
-    {"readProb",            (DL_FUNC) &readProb,            2},
-    {"writeMPS",            (DL_FUNC) &writeMPS,            3},
-    {"writeLP",             (DL_FUNC) &writeLP,             2},
-    {"writeProb",           (DL_FUNC) &writeProb,           2},
-    {"printSol",            (DL_FUNC) &printSol,            2},
-    {"readSol",             (DL_FUNC) &readSol,             2},
-    {"writeSol",            (DL_FUNC) &writeSol,            2},
-    {"printIpt",            (DL_FUNC) &printIpt,            2},
-    {"readIpt",             (DL_FUNC) &readIpt,             2},
-    {"writeIpt",            (DL_FUNC) &writeIpt,            2},
-    {"printMIP",            (DL_FUNC) &printMIP,            2},
-    {"readMIP",             (DL_FUNC) &readMIP,             2},
-    {"writeMIP",            (DL_FUNC) &writeMIP,            2},
-    {"version",             (DL_FUNC) &version,             0},
-    {"bfExists",            (DL_FUNC) &bfExists,            1},
-    {"factorize",           (DL_FUNC) &factorize,           1},
-    {"bfUpdated",           (DL_FUNC) &bfUpdated,           1},
-    {"setBfcp",             (DL_FUNC) &setBfcp,             7},
-    {"getBfcp",             (DL_FUNC) &getBfcp,             1},
-    {"getBhead",            (DL_FUNC) &getBhead,            2},
-    {"getRbind",            (DL_FUNC) &getRbind,            2},
-    {"getCbind",            (DL_FUNC) &getCbind,            2},
-    {"printRanges",         (DL_FUNC) &printRanges,         4},
-    {"mplAllocWksp",        (DL_FUNC) &mplAllocWksp,        1},
-    {"mplFreeWksp",         (DL_FUNC) &mplFreeWksp,         1},
-    {"mplReadModel",        (DL_FUNC) &mplReadModel,        3},
-    {"mplReadData",         (DL_FUNC) &mplReadData,         2},
-    {"mplGenerate",         (DL_FUNC) &mplGenerate,         2},
-    {"mplBuildProb",        (DL_FUNC) &mplBuildProb,        2},
-    {"mplPostsolve",        (DL_FUNC) &mplPostsolve,        3},
+    GLPK_CALL_METHODS(CALL_DEF)
     {NULL, NULL, 0}
 };
 
 
 void R_init_glpkAPI(DllInfo *info) {
+    glpkProfInit(PROF_NUM, profNames);
     R_registerRoutines(info, NULL, callMethods, NULL, NULL);
     R_useDynamicSymbols(info, FALSE);
 }